@@ -9,5 +9,8 @@ public class BallGame : ModuleRules
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "HeadMountedDisplay" });
+
+		// Ability profile overrides and perf benchmark results are JSON
+		PrivateDependencyModuleNames.AddRange(new string[] { "Json", "JsonUtilities" });
 	}
 }
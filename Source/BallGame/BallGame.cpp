@@ -1,7 +1,26 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "BallGame.h"
+#include "StreamlineTestFrameArena.h"
+#include "Misc/CoreDelegates.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, BallGame, "BallGame" );
- 
\ No newline at end of file
+class FBallGameModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		// Per Frame Scratch Memory is Released Once the Whole Frame is Done
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddLambda([]() { FStreamlineFrameArena::Get().EndFrame(); });
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	}
+
+private:
+	FDelegateHandle EndFrameHandle;
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FBallGameModule, BallGame, "BallGame" );
@@ -3,3 +3,5 @@
 #pragma once
 
 #include "CoreMinimal.h"
+
+DECLARE_STATS_GROUP(TEXT("BallGame"), STATGROUP_BallGame, STATCAT_Advanced);
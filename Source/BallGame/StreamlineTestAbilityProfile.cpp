@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StreamlineTestAbilityProfile.h"
+#include "HAL/IConsoleManager.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectIterator.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAbilityProfile, Log, All);
+
+// Transient Profile of Characters without One, Never the Class Default Object, which Loaded Assets Copy
+static UStreamlineTestAbilityProfile* DefaultProfile = nullptr;
+
+static FAutoConsoleCommand ReloadAbilityProfilesCommand(
+	TEXT("BallGame.ReloadAbilityProfiles"),
+	TEXT("Applies Saved/AbilityProfiles/<ProfileName>.json to every loaded ability profile."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		const int32 NumChanged = UStreamlineTestAbilityProfile::ReloadAllOverrides();
+		UE_LOG(LogAbilityProfile, Log, TEXT("Reloaded %d ability profiles"), NumChanged);
+	}));
+
+UStreamlineTestAbilityProfile::UStreamlineTestAbilityProfile()
+{
+}
+
+void UStreamlineTestAbilityProfile::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// Tuning is Copied from the Archetype by Now
+	AuthoredTuning = Tuning;
+	UpdateDerived();
+}
+
+void UStreamlineTestAbilityProfile::PostLoad()
+{
+	Super::PostLoad();
+
+	// Overrides Survive Server Restarts
+	AuthoredTuning = Tuning;
+	ReloadOverrides();
+	UpdateDerived();
+}
+
+#if WITH_EDITOR
+void UStreamlineTestAbilityProfile::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Profiles Take no Overrides in the Editor, so Edits are the Authored Tuning
+	AuthoredTuning = Tuning;
+	UpdateDerived();
+}
+#endif
+
+const UStreamlineTestAbilityProfile& UStreamlineTestAbilityProfile::GetDefaultProfile()
+{
+	if (DefaultProfile == nullptr)
+	{
+		DefaultProfile = NewObject<UStreamlineTestAbilityProfile>(GetTransientPackage(), TEXT("DefaultAbilityProfile"));
+		DefaultProfile->AddToRoot();
+		DefaultProfile->ReloadOverrides();
+	}
+	return *DefaultProfile;
+}
+
+int32 UStreamlineTestAbilityProfile::ReloadAllOverrides()
+{
+	// Class Default Objects are Skipped by the Iterator, the Default Profile is Included if it Exists
+	int32 NumChanged = 0;
+	for (TObjectIterator<UStreamlineTestAbilityProfile> It; It; ++It)
+	{
+		NumChanged += It->ReloadOverrides() ? 1 : 0;
+	}
+	return NumChanged;
+}
+
+FString UStreamlineTestAbilityProfile::GetOverridesPath() const
+{
+	const FString ProfileName = this == DefaultProfile ? TEXT("Default") : GetName();
+	return FPaths::ProjectSavedDir() / TEXT("AbilityProfiles") / ProfileName + TEXT(".json");
+}
+
+bool UStreamlineTestAbilityProfile::ReloadOverrides()
+{
+	// Assets Changed in the Editor would Save the Overrides into the Package, Only the Transient Default is Safe
+	if (GIsEditor && this != DefaultProfile)
+	{
+		return false;
+	}
+
+	// Start from the Authored Tuning so Partial Files Only Change what they List, and Fields or
+	// Files Removed Since the Last Reload Go Back to their Authored Value
+	FStreamlineAbilityTuning NewTuning = AuthoredTuning;
+	FString Json;
+	const FString Path = GetOverridesPath();
+	const bool bHasOverrides = FPaths::FileExists(Path) && FFileHelper::LoadFileToString(Json, *Path);
+	if (bHasOverrides && !FJsonObjectConverter::JsonObjectStringToUStruct(Json, &NewTuning, 0, 0))
+	{
+		UE_LOG(LogAbilityProfile, Warning, TEXT("Ignoring malformed ability overrides %s"), *Path);
+		return false;
+	}
+
+	if (FStreamlineAbilityTuning::StaticStruct()->CompareScriptStruct(&Tuning, &NewTuning, PPF_None))
+	{
+		return false;
+	}
+	Tuning = NewTuning;
+	UpdateDerived();
+	if (bHasOverrides)
+	{
+		UE_LOG(LogAbilityProfile, Log, TEXT("Applied ability overrides %s to %s"), *Path, *GetName());
+	}
+	else
+	{
+		UE_LOG(LogAbilityProfile, Log, TEXT("Restored authored tuning of %s, %s is gone"), *GetName(), *Path);
+	}
+	return true;
+}
+
+void UStreamlineTestAbilityProfile::UpdateDerived()
+{
+	Tuning.DashSpeed = FMath::Max(Tuning.DashSpeed, 1.f);
+	DashTime = Tuning.DashDistance / Tuning.DashSpeed;
+	DashLaunchVelocity = FVector(0.f, 0.f, Tuning.DashHight);
+}
@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "StreamlineTestAbilityProfile.generated.h"
+
+// Tuning Values of the Character Abilities
+USTRUCT(BlueprintType)
+struct FStreamlineAbilityTuning
+{
+	GENERATED_BODY()
+
+	// Multiplier of Movement Throttling
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement")
+	float MoveSpeed = 200.f;
+
+	// Dash Speed
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dashing", meta = (ClampMin = "1.0"))
+	float DashSpeed = 1000.f;
+	// Dash Distance
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dashing")
+	float DashDistance = 300.f;
+	// Dash Hight
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dashing")
+	float DashHight = 250.f;
+
+	// JetBack Flying Power
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "JetBack")
+	float JetPower = 2000.f;
+
+	// Max Allowed Grabbing Range
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GravGun")
+	float GrabRange = 5000.f;
+	// Shooting Power
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GravGun")
+	float ShootPower = 1000000.f;
+};
+
+/**
+ * Ability tuning shared by every character using it, instead of per-instance copies.
+ * Derived constants are computed once when the profile is loaded, edited or reloaded.
+ * Characters without a profile share a transient profile with the default tuning.
+ *
+ * Live servers can be retuned with "BallGame.ReloadAbilityProfiles", which applies
+ * Saved/AbilityProfiles/<ProfileName>.json (or Default.json for the default profile) to every
+ * loaded profile. Overrides are applied on top of the authored tuning each time, so fields missing
+ * from the file, or a deleted file, go back to the value of the asset (or the class defaults).
+ * The class default object is never changed, and in the editor only the transient default profile
+ * takes overrides, so they can not end up saved into assets.
+ */
+UCLASS(BlueprintType)
+class UStreamlineTestAbilityProfile : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UStreamlineTestAbilityProfile();
+
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/** Returns the profile used by characters that do not set one */
+	static const UStreamlineTestAbilityProfile& GetDefaultProfile();
+
+	/** Reapplies the JSON overrides of every loaded profile onto its authored tuning, returns the number of profiles changed */
+	static int32 ReloadAllOverrides();
+
+	/** Returns the path of the JSON overrides of this profile */
+	FString GetOverridesPath() const;
+
+	const FStreamlineAbilityTuning& GetTuning() const { return Tuning; }
+	/** Time a Dash Takes, DashDistance / DashSpeed */
+	float GetDashTime() const { return DashTime; }
+	/** Velocity Lifting the Character Before Dashing */
+	const FVector& GetDashLaunchVelocity() const { return DashLaunchVelocity; }
+
+private:
+	// Rebuilds the Tuning from the Authored One and the JSON Overrides if Present, Returns true if it Changed
+	bool ReloadOverrides();
+	// Computes Derived Constants from the Tuning
+	void UpdateDerived();
+
+	UPROPERTY(EditAnywhere, Category = "Abilities", meta = (ShowOnlyInnerProperties))
+	FStreamlineAbilityTuning Tuning;
+	// Tuning as Loaded from the Asset or Copied from the Archetype, Before any Override
+	FStreamlineAbilityTuning AuthoredTuning;
+
+	// Derived Constants
+	float DashTime;
+	FVector DashLaunchVelocity;
+};
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StreamlineTestAllocationCounter.h"
+#include "HAL/MemoryBase.h"
+
+int32 FStreamlineAllocationCounter::ScopeDepth = 0;
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+	uint64 NumAllocations = 0;
+
+	// Forwards Everything to the Allocator it Wraps, Counting Game Thread Allocations in Tick Scopes
+	class FCountingMallocProxy : public FMalloc
+	{
+	public:
+		explicit FCountingMallocProxy(FMalloc* InInner) : Inner(InInner) {}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			Count1();
+			return Inner->Malloc(Count, Alignment);
+		}
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			Count1();
+			return Inner->TryMalloc(Count, Alignment);
+		}
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			Count1();
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			Count1();
+			return Inner->TryRealloc(Original, Count, Alignment);
+		}
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual bool Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar) override { return Inner->Exec(InWorld, Cmd, Ar); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+	private:
+		FORCEINLINE void Count1()
+		{
+			if (FStreamlineAllocationCounter::ScopeDepth > 0 && IsInGameThread())
+			{
+				++NumAllocations;
+			}
+		}
+
+		FMalloc* Inner;
+	};
+
+	FCountingMallocProxy* Proxy = nullptr;
+}
+
+void FStreamlineAllocationCounter::Install()
+{
+	check(IsInGameThread());
+	if (Proxy == nullptr)
+	{
+		// Blocks Allocated Before are Freed through the Proxy into the Same Allocator, so Swapping is Safe.
+		// The Proxy Stays for the Rest of the Process
+		Proxy = new FCountingMallocProxy(GMalloc);
+		GMalloc = Proxy;
+	}
+}
+
+bool FStreamlineAllocationCounter::IsInstalled()
+{
+	return Proxy != nullptr;
+}
+
+uint64 FStreamlineAllocationCounter::GetNumAllocations()
+{
+	return NumAllocations;
+}
+
+void FStreamlineAllocationCounter::Reset()
+{
+	NumAllocations = 0;
+}
+
+#else
+
+void FStreamlineAllocationCounter::Install() {}
+bool FStreamlineAllocationCounter::IsInstalled() { return false; }
+uint64 FStreamlineAllocationCounter::GetNumAllocations() { return 0; }
+void FStreamlineAllocationCounter::Reset() {}
+
+#endif
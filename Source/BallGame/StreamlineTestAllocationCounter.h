@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Counts game thread heap allocations made while a gameplay tick is running, to check that ticks
+ * stay off the heap once warmed up. Install() wraps GMalloc in a forwarding proxy for the rest of
+ * the process; only allocations inside a STREAMLINE_TICK_ALLOCATION_SCOPE on the game thread are
+ * counted, including those of engine code the tick calls into. Work a tick starts on purpose that
+ * belongs to the engine (physics joints of a grab, instanced batch rebuilds) or that stands in for
+ * player input (bot actions) opens a STREAMLINE_TICK_ALLOCATION_EXEMPT instead. Compiled out of shipping builds.
+ */
+class FStreamlineAllocationCounter
+{
+public:
+	/** Wraps GMalloc, does nothing if already installed */
+	static void Install();
+	static bool IsInstalled();
+
+	/** Allocations and reallocations made inside tick scopes since the last reset */
+	static uint64 GetNumAllocations();
+	static void Reset();
+
+	// Nesting Depth of Tick Scopes on the Game Thread
+	static int32 ScopeDepth;
+};
+
+#if !UE_BUILD_SHIPPING
+struct FStreamlineTickAllocationScope
+{
+	FStreamlineTickAllocationScope() { FStreamlineAllocationCounter::ScopeDepth += IsInGameThread() ? 1 : 0; }
+	~FStreamlineTickAllocationScope() { FStreamlineAllocationCounter::ScopeDepth -= IsInGameThread() ? 1 : 0; }
+};
+#define STREAMLINE_TICK_ALLOCATION_SCOPE() FStreamlineTickAllocationScope ANONYMOUS_VARIABLE(TickAllocationScope)
+
+struct FStreamlineTickAllocationExemptScope
+{
+	FStreamlineTickAllocationExemptScope()
+		: SavedDepth(IsInGameThread() ? FStreamlineAllocationCounter::ScopeDepth : -1)
+	{
+		FStreamlineAllocationCounter::ScopeDepth = SavedDepth >= 0 ? 0 : FStreamlineAllocationCounter::ScopeDepth;
+	}
+	~FStreamlineTickAllocationExemptScope()
+	{
+		FStreamlineAllocationCounter::ScopeDepth = SavedDepth >= 0 ? SavedDepth : FStreamlineAllocationCounter::ScopeDepth;
+	}
+
+	// Depth to Restore, -1 off the Game Thread
+	int32 SavedDepth;
+};
+#define STREAMLINE_TICK_ALLOCATION_EXEMPT() FStreamlineTickAllocationExemptScope ANONYMOUS_VARIABLE(TickAllocationExempt)
+#else
+#define STREAMLINE_TICK_ALLOCATION_SCOPE()
+#define STREAMLINE_TICK_ALLOCATION_EXEMPT()
+#endif
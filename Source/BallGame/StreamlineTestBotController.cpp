@@ -0,0 +1,181 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StreamlineTestBotController.h"
+#include "StreamlineTestAllocationCounter.h"
+#include "StreamlineTestCharacter.h"
+
+AStreamlineTestBotController::AStreamlineTestBotController()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	// Same Group as the Pawn, OnPossess Makes the Pawn Wait for this Tick so Throttles Apply the Same Frame
+	PrimaryActorTick.TickGroup = TG_PrePhysics;
+	bAttachToPawn = true;
+}
+
+void AStreamlineTestBotController::SetSeed(int32 InSeed)
+{
+	Random.Initialize(InSeed);
+	ForwardThrottle = 0.f;
+	RightThrottle = 0.f;
+	ActionCountdown = Random.FRandRange(MinActionInterval, MaxActionInterval);
+	JetCountdown = 0.f;
+}
+
+void AStreamlineTestBotController::Tick(float DeltaTime)
+{
+	STREAMLINE_TICK_ALLOCATION_SCOPE();
+	Super::Tick(DeltaTime);
+
+	AStreamlineTestCharacter* Bot = Cast<AStreamlineTestCharacter>(GetPawn());
+	if (Bot == nullptr)
+	{
+		return;
+	}
+
+	// Axis Handlers Expect to be Fed Every Frame like the Input Component does
+	Bot->MoveForward(ForwardThrottle);
+	Bot->MoveRight(RightThrottle);
+
+	if (JetCountdown > 0.f)
+	{
+		JetCountdown -= DeltaTime;
+		if (JetCountdown <= 0.f)
+		{
+			// Releasing the Jet Key, Input Like the Actions Below
+			STREAMLINE_TICK_ALLOCATION_EXEMPT();
+			Bot->StoppedJetting();
+		}
+	}
+
+	ActionCountdown -= DeltaTime;
+	if (ActionCountdown <= 0.f)
+	{
+		// Actions Stand in for Player Input, which Reaches the Handlers Outside any Tick. Grabbing
+		// Creates a Physics Joint and Fire may Spawn Sounds, both Allocate in the Engine
+		STREAMLINE_TICK_ALLOCATION_EXEMPT();
+		DoRandomAction(Bot);
+		ActionCountdown = Random.FRandRange(MinActionInterval, MaxActionInterval);
+	}
+}
+
+void AStreamlineTestBotController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	// Sharing a Tick Group does not Order Ticks, Player Controllers get the Same Prerequisite from the Engine
+	if (GetPawn() != nullptr)
+	{
+		GetPawn()->AddTickPrerequisiteActor(this);
+	}
+}
+
+void AStreamlineTestBotController::OnUnPossess()
+{
+	AStreamlineTestCharacter* Bot = Cast<AStreamlineTestCharacter>(GetPawn());
+	if (GetPawn() != nullptr)
+	{
+		GetPawn()->RemoveTickPrerequisiteActor(this);
+	}
+	if (Bot != nullptr)
+	{
+		if (JetCountdown > 0.f)
+		{
+			Bot->StoppedJetting();
+		}
+		// Release Held Object so it is not Left Constrained to a Dead Pawn
+		if (Bot->GrabedObject != nullptr)
+		{
+			Bot->DropObject();
+		}
+	}
+	JetCountdown = 0.f;
+
+	Super::OnUnPossess();
+}
+
+void AStreamlineTestBotController::PawnPendingDestroy(APawn* InPawn)
+{
+	// Controllers without a Player State Destroy Themselves Here, Bots Stay to be Given a New Pawn
+	if (InPawn == GetPawn())
+	{
+		UnPossess();
+	}
+}
+
+void AStreamlineTestBotController::DoRandomAction(AStreamlineTestCharacter* Bot)
+{
+	enum EBotAction
+	{
+		ActionMove,
+		ActionStop,
+		ActionLook,
+		ActionJet,
+		ActionDash,
+		ActionGrab,
+		ActionFire,
+		ActionCount
+	};
+
+	switch (Random.RandHelper(ActionCount))
+	{
+	case ActionMove:
+		ForwardThrottle = Random.FRandRange(-1.f, 1.f);
+		RightThrottle = Random.FRandRange(-1.f, 1.f);
+		break;
+	case ActionStop:
+		ForwardThrottle = 0.f;
+		RightThrottle = 0.f;
+		break;
+	case ActionLook:
+	{
+		FRotator NewRotation = GetControlRotation();
+		NewRotation.Yaw += Random.FRandRange(-MaxLookDelta, MaxLookDelta);
+		NewRotation.Pitch = FMath::Clamp(NewRotation.Pitch + Random.FRandRange(-MaxLookDelta, MaxLookDelta) * 0.5f, -60.f, 60.f);
+		SetControlRotation(NewRotation);
+		break;
+	}
+	case ActionJet:
+		if (JetCountdown <= 0.f)
+		{
+			Bot->Jetting();
+		}
+		JetCountdown = Random.FRandRange(0.1f, MaxJetDuration);
+		break;
+	case ActionDash:
+		// Dash Needs a Movement Direction to be Applied
+		if (ForwardThrottle == 0.f && RightThrottle == 0.f)
+		{
+			ForwardThrottle = Random.FRandRange(-1.f, 1.f);
+		}
+		Bot->PreDash();
+		break;
+	case ActionGrab:
+		Grab();
+		break;
+	case ActionFire:
+		Fire();
+		break;
+	}
+}
+
+bool AStreamlineTestBotController::TraceGrabTarget(FHitResult& OutHit)
+{
+	AStreamlineTestCharacter* Bot = Cast<AStreamlineTestCharacter>(GetPawn());
+	return Bot != nullptr && Bot->TraceObject(OutHit);
+}
+
+void AStreamlineTestBotController::Grab()
+{
+	if (AStreamlineTestCharacter* Bot = Cast<AStreamlineTestCharacter>(GetPawn()))
+	{
+		Bot->OnGrab();
+	}
+}
+
+void AStreamlineTestBotController::Fire()
+{
+	if (AStreamlineTestCharacter* Bot = Cast<AStreamlineTestCharacter>(GetPawn()))
+	{
+		Bot->OnFire();
+	}
+}
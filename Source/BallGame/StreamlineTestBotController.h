@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Controller.h"
+#include "StreamlineTestBotController.generated.h"
+
+class AStreamlineTestCharacter;
+
+/**
+ * Bot that drives an AStreamlineTestCharacter through every ability (move, jet, dash, grab, drop, fire)
+ * using the same handlers the player input is bound to. All choices come from a seeded random stream,
+ * so a run with the same seed and frame times is reproducible. Used by the soak commandlet and the perf benchmarks.
+ */
+UCLASS()
+class AStreamlineTestBotController : public AController
+{
+	GENERATED_BODY()
+
+public:
+	AStreamlineTestBotController();
+
+	/** Restarts the random stream, must be called before possessing to get a reproducible run */
+	void SetSeed(int32 InSeed);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual void PawnPendingDestroy(APawn* InPawn) override;
+
+	/** Gravity gun trace of the possessed character, returns false without a pawn or target */
+	bool TraceGrabTarget(FHitResult& OutHit);
+	/** Grabs the targeted object when empty handed, drops the held one otherwise */
+	void Grab();
+	/** Shoots the held object, or pushes the targeted one with an impulse when empty handed */
+	void Fire();
+
+	// Min Time Between Two Actions
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bot")
+	float MinActionInterval = 0.2f;
+	// Max Time Between Two Actions
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bot")
+	float MaxActionInterval = 1.5f;
+	// Max Time a Single Jet Burst Lasts
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bot")
+	float MaxJetDuration = 1.f;
+	// Max Look Rotation per Action in Degrees
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bot")
+	float MaxLookDelta = 90.f;
+
+protected:
+	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
+
+private:
+	// Picks and Runs the Next Random Action
+	void DoRandomAction(AStreamlineTestCharacter* Bot);
+
+	FRandomStream Random;
+	// Throttles Fed to the Movement Handlers Every Tick
+	float ForwardThrottle = 0.f;
+	float RightThrottle = 0.f;
+	// Time Left Before the Next Action
+	float ActionCountdown = 0.f;
+	// Time Left Before Jetting Stops (0 if Not Jetting)
+	float JetCountdown = 0.f;
+};
@@ -1,6 +1,10 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "StreamlineTestCharacter.h"
+#include "StreamlineTestAbilityProfile.h"
+#include "StreamlineTestAllocationCounter.h"
+#include "StreamlineTestEffectPool.h"
+#include "StreamlineTestGameMode.h"
 #include "StreamlineTestProjectile.h"
 #include "Animation/AnimInstance.h"
 #include "Camera/CameraComponent.h"
@@ -18,8 +22,37 @@
 #include "PhysicsEngine/PhysicsConstraintComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Components/AudioComponent.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Net/UnrealNetwork.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogFPChar, Warning, All);
+DEFINE_LOG_CATEGORY_STATIC(LogPawnMemory, Log, All);
+
+// Logs Per Character Memory and Ticking Components, to Compare Client and Dedicated Server Builds
+static FAutoConsoleCommandWithWorld ReportPawnMemoryCommand(
+	TEXT("BallGame.ReportPawnMemory"),
+	TEXT("Logs memory and component counts of every StreamlineTest character in the world."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		int32 NumCharacters = 0;
+		SIZE_T TotalBytes = 0;
+		for (TActorIterator<AStreamlineTestCharacter> It(World); It; ++It)
+		{
+			SIZE_T Bytes = It->GetClass()->GetStructureSize();
+			int32 NumTicking = It->IsActorTickEnabled() ? 1 : 0;
+			for (UActorComponent* Component : It->GetComponents())
+			{
+				Bytes += Component->GetClass()->GetStructureSize() + Component->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+				NumTicking += Component->IsComponentTickEnabled() ? 1 : 0;
+			}
+			UE_LOG(LogPawnMemory, Log, TEXT("%s: %llu bytes, %d components, %d ticking (actor included)"),
+				*It->GetName(), (uint64)Bytes, It->GetComponents().Num(), NumTicking);
+			TotalBytes += Bytes;
+			++NumCharacters;
+		}
+		UE_LOG(LogPawnMemory, Log, TEXT("%d characters, %llu bytes on average"), NumCharacters, NumCharacters ? (uint64)(TotalBytes / NumCharacters) : 0ull);
+	}));
 
 //////////////////////////////////////////////////////////////////////////
 // AStreamlineTestCharacter
@@ -103,11 +136,60 @@ AStreamlineTestCharacter::AStreamlineTestCharacter()
 	JettingSFXSource->SetupAttachment(Mesh1P);
 }
 
+void AStreamlineTestCharacter::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Cosmetic Components (Meshes, VR Controllers, Audio) are Dropped on Dedicated Servers, where Nothing
+	// Renders or Plays them. They are Created Above Anyway, since the Character Blueprint Saves Data for
+	// them and Recreates them on Load. Every use has to handle them being null.
+	if (!IsRunningDedicatedServer())
+	{
+		return;
+	}
+
+	auto DropComponent = [](auto*& Component)
+	{
+		if (Component != nullptr)
+		{
+			// Children Added by Blueprints are Moved to the Parent
+			Component->DestroyComponent(true);
+			Component = nullptr;
+		}
+	};
+	// Leaves First
+	DropComponent(FP_MuzzleLocation);
+	DropComponent(VR_MuzzleLocation);
+	DropComponent(JettingSFXSource);
+	DropComponent(VR_Gun);
+	DropComponent(FP_Gun);
+	DropComponent(R_MotionController);
+	DropComponent(L_MotionController);
+	DropComponent(Mesh1P);
+
+	// The Inherited Third Person Mesh is Never Seen nor Animated, Tick Functions are Registered at Begin Play
+	GetMesh()->PrimaryComponentTick.bCanEverTick = false;
+}
+
+void AStreamlineTestCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// The Owner Sets it Locally when the Input Happens
+	DOREPLIFETIME_CONDITION(AStreamlineTestCharacter, bIsJetting, COND_SkipOwner);
+}
+
 void AStreamlineTestCharacter::BeginPlay()
 {
 	// Call the base class  
 	Super::BeginPlay();
 
+	// Cosmetic Components are Dropped on Dedicated Servers
+	if (Mesh1P == nullptr)
+	{
+		return;
+	}
+
 	//Attach gun mesh component to Skeleton, doing it here because the skeleton is not yet created in the constructor
 	FP_Gun->AttachToComponent(Mesh1P, FAttachmentTransformRules(EAttachmentRule::SnapToTarget, true), TEXT("GripPoint"));
 
@@ -122,37 +204,55 @@ void AStreamlineTestCharacter::BeginPlay()
 		VR_Gun->SetHiddenInGame(true, true);
 		Mesh1P->SetHiddenInGame(false, true);
 	}
-	JettingSFXSource->Stop();
+	// Jetting may have been Replicated before Play Began
+	UpdateJettingSound();
 }
 
 void AStreamlineTestCharacter::Tick(float DeltaTime)
 {
+	STREAMLINE_TICK_ALLOCATION_SCOPE();
 	Super::Tick(DeltaTime);
 
+	// Dash Follows the Launch after a Short Delay. Counted Down Here since a Timer would Allocate its Delegate
+	if (DashDelayCountdown > 0.f)
+	{
+		DashDelayCountdown -= DeltaTime;
+		if (DashDelayCountdown <= 0.f)
+		{
+			Dash();
+		}
+	}
+
+	const UStreamlineTestAbilityProfile& Profile = GetAbilityProfile();
+	bool bDashStarted = false;
 	if (!bIsDashing)
 	{
 		FVector MoveDirection = GetActorForwardVector()* MoveForwardThrottle + GetActorRightVector()* MoveRightThrottle;
 		MoveDirection*= DeltaTime;
-		// Apply JetBack Force if Pressed
-		if (bIsJetting)	
+		// Apply JetBack Force if Pressed, Simulated Copies Only Get the Replicated Movement
+		if (bIsJetting && GetLocalRole() != ROLE_SimulatedProxy)
 		{
-			MoveDirection.Z = JetPower*DeltaTime;
+			MoveDirection.Z = Profile.GetTuning().JetPower*DeltaTime;
 			LaunchCharacter(MoveDirection,false,false);
+			InputLatency.MarkApplied(EStreamlineInputAction::Jet, EStreamlineInputEffect::Launch);
 		}
 		if (MoveForwardThrottle || MoveRightThrottle)
 		{
 			// Apply Movement if Not have Dash Order
 			if (!bDashOrder)	
 			{
-				AddMovementInput(MoveDirection * MoveSpeed);
+				AddMovementInput(MoveDirection * Profile.GetTuning().MoveSpeed);
+				InputLatency.MarkApplied(EStreamlineInputAction::Move, EStreamlineInputEffect::Movement);
 			}
 			// Applying Dash if Not Jetting
 			else if (!bIsJetting && !GetCharacterMovement()->IsFalling())
 			{
 				DashDirection = MoveForwardThrottle ? GetActorForwardVector() * MoveForwardThrottle : GetActorRightVector()* MoveRightThrottle;
-				EndDashLocation = GetActorLocation() + DashDirection * DashDistance;
-				LaunchCharacter(FVector(0,0,DashHight),false,false);
-				GetWorldTimerManager().SetTimer(ApplyDashTimerHandle,this,&AStreamlineTestCharacter::Dash,0.1f,false);				
+				EndDashLocation = GetActorLocation() + DashDirection * Profile.GetTuning().DashDistance;
+				LaunchCharacter(Profile.GetDashLaunchVelocity(),false,false);
+				InputLatency.MarkApplied(EStreamlineInputAction::Dash, EStreamlineInputEffect::Launch);
+				DashDelayCountdown = 0.1f;
+				bDashStarted = true;
 			}
 		}
 	}
@@ -171,6 +271,12 @@ void AStreamlineTestCharacter::Tick(float DeltaTime)
 			bIsDashing = false;
 		}
 	}
+	// Drop Latency Stamp of a Dash Order that was Ignored, Even with an Earlier Dash Still Pending,
+	// so the Pending Dash does not Close the Newer Stamp
+	if (bDashOrder && !bDashStarted)
+	{
+		InputLatency.Clear(EStreamlineInputAction::Dash);
+	}
 	// set DashOrder back to false
 	bDashOrder = false;
 }
@@ -243,11 +349,20 @@ void AStreamlineTestCharacter::EndTouch(const ETouchIndex::Type FingerIndex, con
 
 void AStreamlineTestCharacter::MoveForward(float Value)
 {
+	// Stamp only when Movement Starts, Axis Handlers are Called Every Frame
+	if (Value != 0.f && MoveForwardThrottle == 0.f && MoveRightThrottle == 0.f)
+	{
+		InputLatency.MarkInput(EStreamlineInputAction::Move);
+	}
 	MoveForwardThrottle = Value;
 }
 
 void AStreamlineTestCharacter::MoveRight(float Value)
 {
+	if (Value != 0.f && MoveForwardThrottle == 0.f && MoveRightThrottle == 0.f)
+	{
+		InputLatency.MarkInput(EStreamlineInputAction::Move);
+	}
 	MoveRightThrottle = Value;
 }
 
@@ -279,23 +394,31 @@ bool AStreamlineTestCharacter::EnableTouchscreenMovement(class UInputComponent*
 }
 
 
+const UStreamlineTestAbilityProfile& AStreamlineTestCharacter::GetAbilityProfile() const
+{
+	return AbilityProfile != nullptr ? *AbilityProfile : UStreamlineTestAbilityProfile::GetDefaultProfile();
+}
+
 void AStreamlineTestCharacter::Dash()
 {
 	StartDashLocation = GetActorLocation();
-	DashTime = DashDistance / DashSpeed;
+	DashTime = GetAbilityProfile().GetDashTime();
 	StartDashTime = GetWorld()->GetTimeSeconds();
 	EndDashTime = StartDashTime + DashTime;
 	bIsDashing=true;
+	InputLatency.MarkApplied(EStreamlineInputAction::Dash, EStreamlineInputEffect::Movement);
 }
 
 // Triggers DashOrder to Dash on Next Tick
 void AStreamlineTestCharacter::PreDash()
 {
+	InputLatency.MarkInput(EStreamlineInputAction::Dash);
 	bDashOrder = true;
 }
 
 void AStreamlineTestCharacter::OnGrab()
 {
+	InputLatency.MarkInput(EStreamlineInputAction::Grab);
 	if (GrabedObject != nullptr)
 	{
 		DropObject();
@@ -313,7 +436,7 @@ void AStreamlineTestCharacter::OnGrab()
 bool AStreamlineTestCharacter::TraceObject(FHitResult &Hit)
 {
 	FVector StartLocation = FirstPersonCameraComponent->GetComponentLocation();
-	FVector EndLocation = StartLocation + FirstPersonCameraComponent->GetForwardVector()* GrabRange;
+	FVector EndLocation = StartLocation + FirstPersonCameraComponent->GetForwardVector()* GetAbilityProfile().GetTuning().GrabRange;
 	bool bSuccess= GetWorld()->LineTraceSingleByObjectType(
 	OUT Hit,
 	StartLocation,
@@ -322,32 +445,32 @@ bool AStreamlineTestCharacter::TraceObject(FHitResult &Hit)
 	return bSuccess;
 }
 
-void AStreamlineTestCharacter::GrabObject(FHitResult Hit)
+void AStreamlineTestCharacter::GrabObject(const FHitResult& Hit)
 {
 	UPrimitiveComponent* HittedComponent= Hit.GetComponent();
 	FVector HittedComponentLocation= HittedComponent->GetComponentLocation();
 	HeldSlot->SetWorldLocation(HittedComponentLocation);
 	GrabConstraint->SetConstrainedComponents(HeldSlot,FName::FName(), HittedComponent,Hit.BoneName);
+	InputLatency.MarkApplied(EStreamlineInputAction::Grab, EStreamlineInputEffect::Impulse);
 	Hit.Component->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn,ECollisionResponse::ECR_Ignore);
 	GrabedObject = Hit.GetComponent();
 	FVector GunGrabPoint = FirstPersonCameraComponent->GetComponentLocation() + FirstPersonCameraComponent->GetForwardVector() * 250;
 	HeldSlot->SetWorldLocation(GunGrabPoint);
 	// Play Sound
-	if (GrabSFX != nullptr)
-	{
-		UGameplayStatics::SpawnSoundAttached(GrabSFX,RootComponent);
-	}
+	EmitCosmeticEvent(EStreamlineCosmeticEvent::Grab);
 }
 
 void AStreamlineTestCharacter::DropObject()
 {
 	GrabConstraint->BreakConstraint();
+	InputLatency.MarkApplied(EStreamlineInputAction::Grab, EStreamlineInputEffect::Impulse);
 	GrabedObject->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn,ECollisionResponse::ECR_Block);
 	GrabedObject = nullptr;
 }
 
 void AStreamlineTestCharacter::OnFire()
 {
+	InputLatency.MarkInput(EStreamlineInputAction::Fire);
 	if (GrabedObject != nullptr)
 	{
 		FHitResult Hit;
@@ -366,36 +489,139 @@ void AStreamlineTestCharacter::OnFire()
 	}
 }
 
-void AStreamlineTestCharacter::ShootObject(FHitResult Hit)
+void AStreamlineTestCharacter::ShootObject(const FHitResult& Hit)
 {
-	FVector AppliedForce = FirstPersonCameraComponent->GetForwardVector()*ShootPower;
+	FVector AppliedForce = FirstPersonCameraComponent->GetForwardVector()*GetAbilityProfile().GetTuning().ShootPower;
 	Hit.GetComponent()->AddImpulseAtLocation(AppliedForce,Hit.ImpactPoint,Hit.BoneName);
+	InputLatency.MarkApplied(EStreamlineInputAction::Fire, EStreamlineInputEffect::Impulse);
 	
-	// try and play the sound if specified
-	if (FireSound != nullptr)
-	{
-		UGameplayStatics::PlaySoundAtLocation(this, FireSound, GetActorLocation());
-	}
-	// try and play a firing animation if specified
-	if (FireAnimation != nullptr)
-	{
-		// Get the animation object for the arms mesh
-		UAnimInstance* AnimInstance = Mesh1P->GetAnimInstance();
-		if (AnimInstance != nullptr)
-		{
-			AnimInstance->Montage_Play(FireAnimation, 1.f);
-		}
-	}
+	// Play Sound and Firing Animation
+	EmitCosmeticEvent(EStreamlineCosmeticEvent::Fire);
 }
 
 void AStreamlineTestCharacter::Jetting()
 {
+	InputLatency.MarkInput(EStreamlineInputAction::Jet);
 	bIsJetting = true;
-	JettingSFXSource->Play();
+	UpdateJettingSound();
+	if (!HasAuthority())
+	{
+		ServerSetJetting(true);
+	}
 }
 
 void AStreamlineTestCharacter::StoppedJetting()
 {
 	bIsJetting = false;
-	JettingSFXSource->Stop();
+	UpdateJettingSound();
+	if (!HasAuthority())
+	{
+		ServerSetJetting(false);
+	}
+}
+
+void AStreamlineTestCharacter::ServerSetJetting_Implementation(bool bNewIsJetting)
+{
+	bIsJetting = bNewIsJetting;
+	UpdateJettingSound();
+}
+
+void AStreamlineTestCharacter::OnRep_IsJetting()
+{
+	UpdateJettingSound();
+}
+
+void AStreamlineTestCharacter::UpdateJettingSound()
+{
+	// Cosmetic Components are Dropped on Dedicated Servers
+	if (JettingSFXSource == nullptr)
+	{
+		return;
+	}
+	if (!bIsJetting)
+	{
+		JettingSFXSource->Stop();
+	}
+	else if (!JettingSFXSource->IsPlaying())
+	{
+		JettingSFXSource->Play();
+		InputLatency.MarkApplied(EStreamlineInputAction::Jet, EStreamlineInputEffect::Sound);
+	}
+}
+
+void AStreamlineTestCharacter::EmitCosmeticEvent(EStreamlineCosmeticEvent Event)
+{
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		PlayCosmeticEvent(Event);
+	}
+	if (GetNetMode() == NM_Standalone)
+	{
+		return;
+	}
+	// Only the Server has a Game Mode, it Batches the Event for Remote Players
+	if (!HasAuthority())
+	{
+		ServerEmitCosmeticEvent((uint8)Event);
+	}
+	else if (AStreamlineTestGameMode* GameMode = GetWorld()->GetAuthGameMode<AStreamlineTestGameMode>())
+	{
+		GameMode->GetCosmeticEvents().Queue(this, Event);
+	}
+}
+
+void AStreamlineTestCharacter::ServerEmitCosmeticEvent_Implementation(uint8 Event)
+{
+	if (Event >= (uint8)EStreamlineCosmeticEvent::Count)
+	{
+		return;
+	}
+	// Also Plays it for a Listen Server's Own Player
+	EmitCosmeticEvent((EStreamlineCosmeticEvent)Event);
+}
+
+void AStreamlineTestCharacter::PlayCosmeticEvent(EStreamlineCosmeticEvent Event, UStreamlineTestEffectPool* Pool)
+{
+	switch (Event)
+	{
+	case EStreamlineCosmeticEvent::Fire:
+		// try and play the sound if specified
+		if (FireSound != nullptr)
+		{
+			if (Pool != nullptr)
+			{
+				Pool->PlaySoundAtLocation(FireSound, GetActorLocation());
+			}
+			else
+			{
+				UGameplayStatics::PlaySoundAtLocation(this, FireSound, GetActorLocation());
+			}
+			InputLatency.MarkApplied(EStreamlineInputAction::Fire, EStreamlineInputEffect::Sound);
+		}
+		// try and play a firing animation if specified
+		if (FireAnimation != nullptr && Mesh1P != nullptr)
+		{
+			// Get the animation object for the arms mesh
+			UAnimInstance* AnimInstance = Mesh1P->GetAnimInstance();
+			if (AnimInstance != nullptr)
+			{
+				AnimInstance->Montage_Play(FireAnimation, 1.f);
+			}
+		}
+		break;
+	case EStreamlineCosmeticEvent::Grab:
+		if (GrabSFX != nullptr)
+		{
+			if (Pool != nullptr)
+			{
+				Pool->PlaySoundAtLocation(GrabSFX, GetActorLocation());
+			}
+			else
+			{
+				UGameplayStatics::SpawnSoundAttached(GrabSFX,RootComponent);
+			}
+			InputLatency.MarkApplied(EStreamlineInputAction::Grab, EStreamlineInputEffect::Sound);
+		}
+		break;
+	}
 }
\ No newline at end of file
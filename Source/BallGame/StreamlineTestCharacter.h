@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "StreamlineTestCosmeticEvents.h"
+#include "StreamlineTestInputLatency.h"
 #include "StreamlineTestCharacter.generated.h"
 
 class UInputComponent;
@@ -14,12 +16,17 @@ class UMotionControllerComponent;
 class UAnimMontage;
 class USoundBase;
 class UAudioComponent;
+class UStreamlineTestAbilityProfile;
+class UStreamlineTestEffectPool;
 
 UCLASS(config=Game)
 class AStreamlineTestCharacter : public ACharacter
 {
 	GENERATED_BODY()
 
+	// Bots Drive the Character through the Same Handlers as Player Input
+	friend class AStreamlineTestBotController;
+
 	/** Pawn mesh: 1st person view (arms; seen only by self) */
 	UPROPERTY(VisibleDefaultsOnly, Category=Mesh)
 	USkeletalMeshComponent* Mesh1P;
@@ -55,6 +62,9 @@ class AStreamlineTestCharacter : public ACharacter
 public:
 	AStreamlineTestCharacter();
 
+	virtual void PostInitializeComponents() override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 protected:
 	virtual void BeginPlay();
 
@@ -144,6 +154,14 @@ public:
 	USkeletalMeshComponent* GetMesh1P() const { return Mesh1P; }
 	/** Returns FirstPersonCameraComponent subobject **/
 	UCameraComponent* GetFirstPersonCameraComponent() const { return FirstPersonCameraComponent; }
+	/** Returns the component held by the gravity gun, nullptr if empty handed **/
+	UPrimitiveComponent* GetGrabedObject() const { return GrabedObject; }
+
+	/**
+	 * Plays the sounds and animation of a cosmetic event.
+	 * @param Pool	Audio sources to use for one shot sounds, nullptr to spawn them (events generated locally)
+	 */
+	void PlayCosmeticEvent(EStreamlineCosmeticEvent Event, UStreamlineTestEffectPool* Pool = nullptr);
 
 // My Added Section of Code
 protected:
@@ -152,7 +170,13 @@ protected:
 	// Added Movement Throttling Multiplyed with Move Speed
 	float MoveForwardThrottle=0;
 	float MoveRightThrottle=0;
-	float MoveSpeed=200.f;
+	// Shared Ability Tuning (Move Speed, Dash, JetBack, GravGun), Default Tuning if not Set
+	UPROPERTY(EditDefaultsOnly,BlueprintReadOnly, Category = "Abilities")
+	UStreamlineTestAbilityProfile* AbilityProfile;
+	// Returns the Ability Profile in Use
+	const UStreamlineTestAbilityProfile& GetAbilityProfile() const;
+	// Input to Effect Latency Tracing, Enabled with BallGame.InputLatency
+	FStreamlineInputLatencyTracker InputLatency;
 
 // Dashing Part
 	// Starts Dash on Next Tick
@@ -160,13 +184,7 @@ protected:
 	// Prevent any Movement or Flying from Happening
 	bool bIsDashing=false;
 
-	// Dash Speed
-	UPROPERTY(EditDefaultsOnly,BlueprintReadWrite, Category = "Dashing")
-	float DashSpeed= 1000.f;
-	// Dash Distance
-	UPROPERTY(EditDefaultsOnly,BlueprintReadWrite, Category = "Dashing")
-	float DashDistance= 300.f;
-	// Dash Time
+	// Dash Time of the Current Dash
 	float DashTime= 1.f;
 	// Dash Direction
 	FVector DashDirection= FVector::ZeroVector;
@@ -178,11 +196,8 @@ protected:
 	float StartDashTime;
 	// World Time at Dash End
 	float EndDashTime;
-	// Dash Hight
-	UPROPERTY(EditDefaultsOnly,BlueprintReadWrite, Category = "Dashing")
-	float DashHight= 250.f;
-	// TimerHandle for Dashing After elevation
-	FTimerHandle ApplyDashTimerHandle;
+	// Time Left Before Dashing After Elevation (0 if No Dash is Pending)
+	float DashDelayCountdown = 0.f;
 	// Apply Dash
 	UFUNCTION()
 	void Dash();
@@ -199,12 +214,6 @@ protected:
 	class UPhysicsConstraintComponent* GrabConstraint;
 	// Reference to Grabbed Object
 	class UPrimitiveComponent* GrabedObject;
-	// Max Allowed Grabbing Range
-	UPROPERTY(EditDefaultsOnly,BlueprintReadWrite, Category = "GravGun")
-	float GrabRange = 5000.f;
-	// Shooting Power
-	UPROPERTY(EditDefaultsOnly,BlueprintReadWrite, Category = "GravGun")
-	float ShootPower = 1000000.f;
 	// Grab Sound Effect
 	UPROPERTY(EditDefaultsOnly,BlueprintReadWrite, Category = "GravGun")
 	USoundBase* GrabSFX;
@@ -216,25 +225,37 @@ protected:
 	bool TraceObject(FHitResult & Hit);
 	// Grabs Hitted Object
 	UFUNCTION()
-	void GrabObject(FHitResult Hit);
+	void GrabObject(const FHitResult& Hit);
 	// Breaks Constrain with GrabbedObject 
 	UFUNCTION()
 	void DropObject();
 	// Apply Force to Object
 	UFUNCTION()
-	void ShootObject(FHitResult Hit);
+	void ShootObject(const FHitResult& Hit);
 
 // JetBack Part
-	// Trigger for Jetting
+	// Trigger for Jetting, Replicated so the Jet Sound Follows the State on Remote Players
+	UPROPERTY(ReplicatedUsing = OnRep_IsJetting)
 	bool bIsJetting = false;
-	// JetBack Flying Power
-	UPROPERTY(EditDefaultsOnly,BlueprintReadWrite, Category = "JetBack")
-	float JetPower = 2000.f;
 	// Triggers Jetting
 	void Jetting();
 	// Stops Jetting Trigger
 	void StoppedJetting();
+	// Sends the Owning Player's Jetting State to the Server
+	UFUNCTION(Server, Reliable)
+	void ServerSetJetting(bool bNewIsJetting);
+	UFUNCTION()
+	void OnRep_IsJetting();
+	// Starts or Stops the Jet Sound to Match bIsJetting
+	void UpdateJettingSound();
 	// Jetting Sound Effect
 	UPROPERTY(EditDefaultsOnly,BlueprintReadWrite, Category = "JetBack")
 	UAudioComponent* JettingSFXSource;
+
+// Cosmetic Events
+	// Plays the Event Locally and Queues it for Remote Players on the Server
+	void EmitCosmeticEvent(EStreamlineCosmeticEvent Event);
+	// Forwards a One Shot Event of the Owning Player to the Server, which Queues it for the Others
+	UFUNCTION(Server, Unreliable)
+	void ServerEmitCosmeticEvent(uint8 Event);
 };
\ No newline at end of file
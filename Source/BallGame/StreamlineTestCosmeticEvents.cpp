@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StreamlineTestCosmeticEvents.h"
+#include "BallGame.h"
+#include "StreamlineTestCharacter.h"
+#include "StreamlineTestPlayerController.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetSerialization.h"
+#include "Engine/PackageMapClient.h"
+#include "Engine/World.h"
+#include "Net/DataBunch.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cosmetic Events Queued"), STAT_CosmeticEventsQueued, STATGROUP_BallGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cosmetic Events Coalesced"), STAT_CosmeticEventsCoalesced, STATGROUP_BallGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cosmetic Events Culled"), STAT_CosmeticEventsCulled, STATGROUP_BallGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cosmetic Events Sent"), STAT_CosmeticEventsSent, STATGROUP_BallGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cosmetic Event Bytes Sent"), STAT_CosmeticEventBytesSent, STATGROUP_BallGame);
+
+FStreamlineCosmeticEventChannel::FStreamlineCosmeticEventChannel()
+	: Writer(nullptr, 256 * 8)
+{
+}
+
+void FStreamlineCosmeticEventChannel::Queue(AStreamlineTestCharacter* Instigator, EStreamlineCosmeticEvent Event)
+{
+	INC_DWORD_STAT(STAT_CosmeticEventsQueued);
+
+	for (FQueuedEvent& Queued : Events)
+	{
+		if (Queued.Instigator != Instigator)
+		{
+			continue;
+		}
+		// Same Event Twice in a Frame Plays Once
+		if (Queued.Event == Event)
+		{
+			INC_DWORD_STAT(STAT_CosmeticEventsCoalesced);
+			return;
+		}
+	}
+
+	FQueuedEvent& Queued = Events.AddDefaulted_GetRef();
+	Queued.Instigator = Instigator;
+	Queued.Location = Instigator->GetActorLocation();
+	Queued.Event = Event;
+}
+
+void FStreamlineCosmeticEventChannel::Flush(UWorld* World, float CullDistance)
+{
+	if (Events.Num() == 0)
+	{
+		return;
+	}
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		AStreamlineTestPlayerController* PlayerController = Cast<AStreamlineTestPlayerController>(It->Get());
+		UNetConnection* Connection = PlayerController ? PlayerController->GetNetConnection() : nullptr;
+		// Local Players Already Played the Events where they Happened
+		if (Connection == nullptr || PlayerController->IsLocalController())
+		{
+			continue;
+		}
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		const AActor* ViewTarget = PlayerController->GetViewTarget();
+
+		Writer.Reset();
+		Writer.PackageMap = Connection->PackageMap;
+		int32 NumWritten = 0;
+		for (const FQueuedEvent& Queued : Events)
+		{
+			AStreamlineTestCharacter* Instigator = Queued.Instigator.Get();
+			// The Owning Player Played its Own Event Locally
+			if (Instigator == nullptr || Instigator->GetController() == PlayerController)
+			{
+				continue;
+			}
+			if (FVector::DistSquared(ViewLocation, Queued.Location) > FMath::Square(CullDistance)
+				|| !Instigator->IsNetRelevantFor(PlayerController, ViewTarget, ViewLocation))
+			{
+				INC_DWORD_STAT(STAT_CosmeticEventsCulled);
+				continue;
+			}
+
+			Writer.WriteBit(1);
+			uint32 EventType = (uint32)Queued.Event;
+			Writer.SerializeInt(EventType, (uint32)EStreamlineCosmeticEvent::Count);
+			UObject* Object = Instigator;
+			Connection->PackageMap->SerializeObject(Writer, AStreamlineTestCharacter::StaticClass(), Object);
+			++NumWritten;
+		}
+
+		if (NumWritten > 0)
+		{
+			Writer.WriteBit(0);
+			Payload.Reset();
+			Payload.Append(Writer.GetData(), Writer.GetNumBytes());
+			PlayerController->ClientReceiveCosmeticEvents(Payload);
+			INC_DWORD_STAT_BY(STAT_CosmeticEventsSent, NumWritten);
+			INC_DWORD_STAT_BY(STAT_CosmeticEventBytesSent, Payload.Num());
+		}
+	}
+
+	Writer.PackageMap = nullptr;
+	Events.Reset();
+}
+
+void FStreamlineCosmeticEventChannel::Dispatch(UNetConnection* Connection, const TArray<uint8>& Data, UStreamlineTestEffectPool* Pool)
+{
+	if (Connection == nullptr)
+	{
+		return;
+	}
+
+	FNetBitReader Reader(Connection->PackageMap, const_cast<uint8*>(Data.GetData()), Data.Num() * 8);
+	while (!Reader.AtEnd() && Reader.ReadBit())
+	{
+		uint32 EventType = 0;
+		Reader.SerializeInt(EventType, (uint32)EStreamlineCosmeticEvent::Count);
+		UObject* Object = nullptr;
+		Connection->PackageMap->SerializeObject(Reader, AStreamlineTestCharacter::StaticClass(), Object);
+		if (Reader.IsError())
+		{
+			break;
+		}
+
+		// Characters not Replicated to this Client Yet are Skipped, Events are Unreliable Anyway
+		if (AStreamlineTestCharacter* Instigator = Cast<AStreamlineTestCharacter>(Object))
+		{
+			Instigator->PlayCosmeticEvent((EStreamlineCosmeticEvent)EventType, Pool);
+		}
+	}
+}
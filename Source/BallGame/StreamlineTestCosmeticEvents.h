@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/CoreNet.h"
+
+class AStreamlineTestCharacter;
+class UNetConnection;
+class UStreamlineTestEffectPool;
+class UWorld;
+
+// One Shot Cosmetic Events Forwarded to Remote Players. Ongoing State like the Jet Loop is a
+// Replicated Property Instead, a Lost Stop Event would Leave it Playing
+enum class EStreamlineCosmeticEvent : uint8
+{
+	Fire,
+	Grab,
+	Count
+};
+
+/**
+ * Server side batching of one shot cosmetic events (fire, grab).
+ * Events queued during a frame are coalesced per character, culled per connection by distance and
+ * net relevancy, and packed into one bitstream sent with a single unreliable client RPC per connection,
+ * instead of one multicast RPC per event. Owned and flushed at the end of the frame by AStreamlineTestGameMode.
+ * Remote players' events reach the server through AStreamlineTestCharacter::ServerEmitCosmeticEvent.
+ *
+ * Stream layout per event: 1 continue bit, event type, character NetGUID. A 0 bit ends the stream.
+ * Locations are not sent, clients play the effect where their copy of the character is.
+ */
+class FStreamlineCosmeticEventChannel
+{
+public:
+	FStreamlineCosmeticEventChannel();
+
+	/** Queues an event for this frame, merging it with an earlier one of the same character if possible */
+	void Queue(AStreamlineTestCharacter* Instigator, EStreamlineCosmeticEvent Event);
+
+	/** Sends the queued events to every remote player they are relevant to and clears the queue */
+	void Flush(UWorld* World, float CullDistance);
+
+	/** Unpacks a stream received from the server and plays its events */
+	static void Dispatch(UNetConnection* Connection, const TArray<uint8>& Data, UStreamlineTestEffectPool* Pool);
+
+private:
+	struct FQueuedEvent
+	{
+		TWeakObjectPtr<AStreamlineTestCharacter> Instigator;
+		FVector Location;
+		EStreamlineCosmeticEvent Event;
+	};
+
+	TArray<FQueuedEvent> Events;
+	// Reused for Every Connection and Frame, so Flushing does not Allocate Once they have Grown
+	FNetBitWriter Writer;
+	TArray<uint8> Payload;
+};
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StreamlineTestEffectPool.h"
+#include "Components/AudioComponent.h"
+#include "Sound/SoundBase.h"
+
+void UStreamlineTestEffectPool::PlaySoundAtLocation(USoundBase* Sound, const FVector& Location)
+{
+	if (Sound == nullptr)
+	{
+		return;
+	}
+
+	UAudioComponent* Source = nullptr;
+	for (UAudioComponent* Candidate : Sources)
+	{
+		if (!Candidate->IsPlaying())
+		{
+			Source = Candidate;
+			break;
+		}
+	}
+
+	if (Source == nullptr)
+	{
+		if (Sources.Num() < PoolSize)
+		{
+			// Sources are Created on First Use and Kept for the Lifetime of the Pool
+			Source = NewObject<UAudioComponent>(GetOwner());
+			Source->bAutoActivate = false;
+			Source->bAutoDestroy = false;
+			Source->SetUsingAbsoluteLocation(true);
+			Source->RegisterComponent();
+			Sources.Add(Source);
+		}
+		else
+		{
+			Source = Sources[NextSource];
+			NextSource = (NextSource + 1) % Sources.Num();
+		}
+	}
+
+	Source->SetWorldLocation(Location);
+	Source->SetSound(Sound);
+	Source->Play();
+}
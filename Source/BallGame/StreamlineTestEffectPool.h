@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "StreamlineTestEffectPool.generated.h"
+
+class UAudioComponent;
+class USoundBase;
+
+/**
+ * Fixed set of audio sources reused for one shot effects received from the server,
+ * so a burst of remote fire and grab events does not spawn a component per sound.
+ */
+UCLASS(ClassGroup = (Audio))
+class UStreamlineTestEffectPool : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** Plays a sound at a world location on the next free source, stealing the oldest one if all are busy */
+	void PlaySoundAtLocation(USoundBase* Sound, const FVector& Location);
+
+	// Max Number of Sounds Played at Once
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Effects")
+	int32 PoolSize = 8;
+
+private:
+	UPROPERTY(Transient)
+	TArray<UAudioComponent*> Sources;
+
+	// Next Source to Steal when Every Source is Playing
+	int32 NextSource = 0;
+};
@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StreamlineTestFrameArena.h"
+#include "BallGame.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFrameArena, Log, All);
+
+DECLARE_MEMORY_STAT(TEXT("Frame Arena High Water"), STAT_FrameArenaHighWater, STATGROUP_BallGame);
+DECLARE_MEMORY_STAT(TEXT("Frame Arena Peak High Water"), STAT_FrameArenaPeakHighWater, STATGROUP_BallGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Frame Arena Heap Allocations"), STAT_FrameArenaHeapAllocations, STATGROUP_BallGame);
+
+static FAutoConsoleCommand ReportFrameArenaCommand(
+	TEXT("BallGame.FrameArena.Report"),
+	TEXT("Logs the frame arena high-water marks and how often it had to grow."),
+	FConsoleCommandDelegate::CreateLambda([]() { FStreamlineFrameArena::Get().Report(); }));
+
+FStreamlineFrameArena& FStreamlineFrameArena::Get()
+{
+	check(IsInGameThread());
+	static FStreamlineFrameArena Arena;
+	return Arena;
+}
+
+FStreamlineFrameArena::~FStreamlineFrameArena()
+{
+	for (const FBlock& Block : Blocks)
+	{
+		FMemory::Free(Block.Data);
+	}
+}
+
+void* FStreamlineFrameArena::Alloc(SIZE_T Size, uint32 Alignment)
+{
+	checkSlow(IsInGameThread());
+	// DEFAULT_ALIGNMENT is 0, Fall Back to the Heap's Minimum
+	Alignment = FMath::Max<uint32>(Alignment, 16);
+
+	// Move to the Next Block Large Enough, Reusing Blocks Kept from Previous Frames
+	SIZE_T AlignedOffset = 0;
+	for (; CurrentBlock < Blocks.Num(); ++CurrentBlock, BlockOffset = 0)
+	{
+		const FBlock& Block = Blocks[CurrentBlock];
+		AlignedOffset = Align(Block.Data + BlockOffset, Alignment) - Block.Data;
+		if (AlignedOffset + Size <= Block.Size)
+		{
+			break;
+		}
+	}
+
+	if (CurrentBlock == Blocks.Num())
+	{
+		FBlock& Block = Blocks.AddDefaulted_GetRef();
+		Block.Size = FMath::Max<SIZE_T>(BlockSize, Align(Size, BlockSize));
+		Block.Data = (uint8*)FMemory::Malloc(Block.Size, Alignment);
+		++NumHeapAllocations;
+		AlignedOffset = 0;
+		INC_DWORD_STAT(STAT_FrameArenaHeapAllocations);
+	}
+
+	void* Result = Blocks[CurrentBlock].Data + AlignedOffset;
+	BytesUsed += AlignedOffset + Size - BlockOffset;
+	BlockOffset = AlignedOffset + Size;
+	return Result;
+}
+
+void FStreamlineFrameArena::EndFrame()
+{
+	LastFrameHighWater = BytesUsed;
+	PeakHighWater = FMath::Max(PeakHighWater, BytesUsed);
+	SET_MEMORY_STAT(STAT_FrameArenaHighWater, LastFrameHighWater);
+	SET_MEMORY_STAT(STAT_FrameArenaPeakHighWater, PeakHighWater);
+
+	CurrentBlock = 0;
+	BlockOffset = 0;
+	BytesUsed = 0;
+}
+
+void FStreamlineFrameArena::Report() const
+{
+	SIZE_T Reserved = 0;
+	for (const FBlock& Block : Blocks)
+	{
+		Reserved += Block.Size;
+	}
+	UE_LOG(LogFrameArena, Log, TEXT("Frame arena: last frame %llu bytes, peak %llu bytes, %d blocks (%llu bytes reserved), %d heap allocations since startup"),
+		(uint64)LastFrameHighWater, (uint64)PeakHighWater, Blocks.Num(), (uint64)Reserved, NumHeapAllocations);
+}
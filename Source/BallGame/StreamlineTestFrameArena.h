@@ -0,0 +1,157 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ContainerAllocationPolicies.h"
+
+/**
+ * Linear allocator for game thread scratch data that only lives for the current frame.
+ * Allocation bumps an offset in blocks that are kept between frames, the whole arena is reset
+ * at the end of every frame by the BallGame module. Once the blocks have grown to the busiest
+ * frame, gameplay ticks do not touch the heap for their scratch data anymore.
+ * Use "BallGame.FrameArena.Report" or "stat BallGame" to see the high-water marks.
+ */
+class FStreamlineFrameArena
+{
+public:
+	/** Returns the game thread arena */
+	static FStreamlineFrameArena& Get();
+
+	~FStreamlineFrameArena();
+
+	/** Allocates memory valid until the end of the current frame */
+	void* Alloc(SIZE_T Size, uint32 Alignment);
+
+	/** Releases all allocations of the frame and records its high-water mark */
+	void EndFrame();
+
+	/** Bytes handed out during the current frame */
+	SIZE_T GetBytesUsed() const { return BytesUsed; }
+	/** Bytes handed out by the previous frame */
+	SIZE_T GetLastFrameHighWater() const { return LastFrameHighWater; }
+	/** Largest number of bytes handed out by a single frame */
+	SIZE_T GetPeakHighWater() const { return PeakHighWater; }
+	/** Number of blocks the arena had to allocate from the heap since startup */
+	int32 GetNumHeapAllocations() const { return NumHeapAllocations; }
+
+	/** Logs the high-water marks */
+	void Report() const;
+
+private:
+	struct FBlock
+	{
+		uint8* Data;
+		SIZE_T Size;
+	};
+
+	// Default Size of a New Block, Bigger Allocations Get a Block of their Own
+	static constexpr SIZE_T BlockSize = 64 * 1024;
+
+	TArray<FBlock, TInlineAllocator<8>> Blocks;
+	int32 CurrentBlock = 0;
+	SIZE_T BlockOffset = 0;
+	SIZE_T BytesUsed = 0;
+	SIZE_T LastFrameHighWater = 0;
+	SIZE_T PeakHighWater = 0;
+	int32 NumHeapAllocations = 0;
+};
+
+/**
+ * TArray compatible allocator on the frame arena, modeled on TMemStackAllocator.
+ * Containers using it must not outlive the frame. Growing copies into a fresh allocation,
+ * so reserve up front when the size is known.
+ */
+template<uint32 Alignment = DEFAULT_ALIGNMENT>
+class TStreamlineFrameArenaAllocator
+{
+public:
+	using SizeType = int32;
+
+	enum { NeedsElementType = true };
+	enum { RequireRangeCheck = true };
+
+	template<typename ElementType>
+	class ForElementType
+	{
+	public:
+		ForElementType()
+			: Data(nullptr)
+		{
+		}
+
+		FORCEINLINE void MoveToEmpty(ForElementType& Other)
+		{
+			checkSlow(this != &Other);
+			Data = Other.Data;
+			Other.Data = nullptr;
+		}
+
+		FORCEINLINE ElementType* GetAllocation() const
+		{
+			return Data;
+		}
+
+		void ResizeAllocation(SizeType PreviousNumElements, SizeType NumElements, SIZE_T NumBytesPerElement)
+		{
+			ElementType* OldData = Data;
+			if (NumElements)
+			{
+				// Arena Memory can't Grow in Place, the Old Allocation is Dropped with the Frame
+				Data = (ElementType*)FStreamlineFrameArena::Get().Alloc(NumElements * NumBytesPerElement, FMath::Max<uint32>(Alignment, alignof(ElementType)));
+				if (OldData && PreviousNumElements)
+				{
+					FMemory::Memcpy(Data, OldData, FMath::Min(PreviousNumElements, NumElements) * NumBytesPerElement);
+				}
+			}
+			else
+			{
+				Data = nullptr;
+			}
+		}
+
+		FORCEINLINE SizeType CalculateSlackReserve(SizeType NumElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackReserve(NumElements, NumBytesPerElement, false, Alignment);
+		}
+		FORCEINLINE SizeType CalculateSlackShrink(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackShrink(NumElements, NumAllocatedElements, NumBytesPerElement, false, Alignment);
+		}
+		FORCEINLINE SizeType CalculateSlackGrow(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackGrow(NumElements, NumAllocatedElements, NumBytesPerElement, false, Alignment);
+		}
+
+		SIZE_T GetAllocatedSize(SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return NumAllocatedElements * NumBytesPerElement;
+		}
+
+		bool HasAllocation() const
+		{
+			return !!Data;
+		}
+
+		SizeType GetInitialCapacity() const
+		{
+			return 0;
+		}
+
+	private:
+		ElementType* Data;
+	};
+
+	typedef ForElementType<FScriptContainerElement> ForAnyElementType;
+};
+
+template <uint32 Alignment>
+struct TAllocatorTraits<TStreamlineFrameArenaAllocator<Alignment>> : TAllocatorTraitsBase<TStreamlineFrameArenaAllocator<Alignment>>
+{
+	enum { IsZeroConstruct = true };
+};
+
+/** Set/Map allocator keeping elements, bits and hash on the frame arena */
+typedef TSetAllocator<
+	TSparseArrayAllocator<TStreamlineFrameArenaAllocator<>, TStreamlineFrameArenaAllocator<>>,
+	TStreamlineFrameArenaAllocator<>> FStreamlineFrameArenaSetAllocator;
@@ -1,8 +1,10 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "StreamlineTestGameMode.h"
+#include "StreamlineTestAllocationCounter.h"
 #include "StreamlineTestHUD.h"
 #include "StreamlineTestCharacter.h"
+#include "StreamlineTestPlayerController.h"
 #include "UObject/ConstructorHelpers.h"
 
 AStreamlineTestGameMode::AStreamlineTestGameMode()
@@ -14,4 +16,20 @@ AStreamlineTestGameMode::AStreamlineTestGameMode()
 
 	// use our custom HUD class
 	HUDClass = AStreamlineTestHUD::StaticClass();
+
+	// our player controller receives batched cosmetic events
+	PlayerControllerClass = AStreamlineTestPlayerController::StaticClass();
+
+	// flush cosmetic events once everything in the frame had a chance to queue them
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
+	CosmeticEventCullDistance = 15000.f;
+}
+
+void AStreamlineTestGameMode::Tick(float DeltaSeconds)
+{
+	STREAMLINE_TICK_ALLOCATION_SCOPE();
+	Super::Tick(DeltaSeconds);
+
+	CosmeticEvents.Flush(GetWorld(), CosmeticEventCullDistance);
 }
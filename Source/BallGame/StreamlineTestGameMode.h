@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "StreamlineTestCosmeticEvents.h"
 #include "StreamlineTestGameMode.generated.h"
 
 UCLASS(minimalapi)
@@ -13,6 +14,19 @@ class AStreamlineTestGameMode : public AGameModeBase
 
 public:
 	AStreamlineTestGameMode();
+
+	/** Flushes the cosmetic events queued during the frame */
+	virtual void Tick(float DeltaSeconds) override;
+
+	/** Returns the channel characters queue their cosmetic events on */
+	FStreamlineCosmeticEventChannel& GetCosmeticEvents() { return CosmeticEvents; }
+
+	/** Cosmetic events further than this from a player's view point are not sent to them */
+	UPROPERTY(EditDefaultsOnly, Category = Network)
+	float CosmeticEventCullDistance;
+
+private:
+	FStreamlineCosmeticEventChannel CosmeticEvents;
 };
 
 
@@ -1,17 +1,44 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "StreamlineTestHUD.h"
+#include "StreamlineTestInstanceBatcher.h"
 #include "Engine/Canvas.h"
 #include "Engine/Texture2D.h"
 #include "TextureResource.h"
 #include "CanvasItem.h"
 #include "UObject/ConstructorHelpers.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarInstancedProps(
+	TEXT("BallGame.InstancedProps"),
+	1,
+	TEXT("Draws identical props and resting balls through hierarchical instanced batches.\n")
+	TEXT("Read when the HUD begins play. 0: off, 1: on (default)"));
 
 AStreamlineTestHUD::AStreamlineTestHUD()
 {
-	// Set the crosshair texture
-	static ConstructorHelpers::FObjectFinder<UTexture2D> CrosshairTexObj(TEXT("/Game/FirstPerson/Textures/FirstPersonCrosshair"));
-	CrosshairTex = CrosshairTexObj.Object;
+	// Set the crosshair texture, Dedicated Servers Never Draw a HUD
+	if (!IsRunningDedicatedServer())
+	{
+		static ConstructorHelpers::FObjectFinder<UTexture2D> CrosshairTexObj(TEXT("/Game/FirstPerson/Textures/FirstPersonCrosshair"));
+		CrosshairTex = CrosshairTexObj.Object;
+	}
+}
+
+void AStreamlineTestHUD::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// The HUD Only Exists where Something Renders, One Batcher is Shared by all Local Players
+	if (CVarInstancedProps.GetValueOnGameThread() != 0)
+	{
+		TActorIterator<AStreamlineTestInstanceBatcher> It(GetWorld());
+		if (!It)
+		{
+			GetWorld()->SpawnActor<AStreamlineTestInstanceBatcher>();
+		}
+	}
 }
 
 
@@ -19,7 +46,11 @@ void AStreamlineTestHUD::DrawHUD()
 {
 	Super::DrawHUD();
 
-	// Draw very simple crosshair
+	// Draw very simple crosshair, Textures have no Resource in Commandlets without Rendering
+	if (CrosshairTex == nullptr || CrosshairTex->Resource == nullptr)
+	{
+		return;
+	}
 
 	// find center of the Canvas
 	const FVector2D Center(Canvas->ClipX * 0.5f, Canvas->ClipY * 0.5f);
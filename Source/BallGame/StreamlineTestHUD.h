@@ -17,6 +17,9 @@ public:
 	/** Primary draw call for the HUD */
 	virtual void DrawHUD() override;
 
+protected:
+	virtual void BeginPlay() override;
+
 private:
 	/** Crosshair asset pointer */
 	class UTexture2D* CrosshairTex;
@@ -0,0 +1,201 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StreamlineTestHeadlessWorld.h"
+#include "StreamlineTestBotController.h"
+#include "StreamlineTestCharacter.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/GameModeBase.h"
+#include "Misc/App.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogHeadlessWorld, Log, All);
+
+UWorld* StreamlineTestHeadlessWorld::Create(const FString& MapName, bool bListen)
+{
+	// Game Modes are Created through the Game Instance, so the World Needs One
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone();
+
+	FWorldContext* Context = GameInstance->GetWorldContext();
+	UWorld* World = Context->World();
+	if (!MapName.IsEmpty())
+	{
+		UPackage* MapPackage = LoadPackage(nullptr, *MapName, LOAD_None);
+		UWorld* MapWorld = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+		if (MapWorld == nullptr)
+		{
+			UE_LOG(LogHeadlessWorld, Error, TEXT("Could not load map %s"), *MapName);
+			Destroy(World);
+			return nullptr;
+		}
+		// Swap the Standalone Dummy World for the Loaded Map
+		World->DestroyWorld(false);
+		MapWorld->WorldType = EWorldType::Game;
+		MapWorld->AddToRoot();
+		MapWorld->SetGameInstance(GameInstance);
+		Context->SetCurrentWorld(MapWorld);
+		if (!MapWorld->bIsWorldInitialized)
+		{
+			MapWorld->InitWorld();
+		}
+		World = MapWorld;
+	}
+
+	FURL URL;
+	World->SetGameMode(URL);
+	if (bListen && !World->Listen(URL))
+	{
+		UE_LOG(LogHeadlessWorld, Warning, TEXT("World failed to listen on port %d"), URL.Port);
+	}
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+	return World;
+}
+
+namespace
+{
+	// Arena Half Size, the Walls Stand Right Outside
+	const float ArenaHalfSize = 5000.f;
+	// Distance Between Prop Centers on the Ring, Twice the 50 cm Prop Size so they Spawn Apart
+	const float PropSpacing = 100.f;
+}
+
+float StreamlineTestHeadlessWorld::GetPropRingRadius(int32 NumProps)
+{
+	// Grows with the Prop Count, Kept 5 m Inside the Walls
+	return FMath::Clamp(NumProps * PropSpacing / (2.f * PI), 1500.f, ArenaHalfSize - 500.f);
+}
+
+void StreamlineTestHeadlessWorld::SpawnArena(UWorld* World, int32 NumProps)
+{
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (CubeMesh == nullptr)
+	{
+		UE_LOG(LogHeadlessWorld, Error, TEXT("Could not load the engine cube mesh for the arena"));
+		return;
+	}
+
+	// Floor: 100 m x 100 m Slab with its Top at Z = 0. Static Meshes Refuse a New Mesh once Play
+	// has Begun, so the Arena is Movable like the Props
+	AStaticMeshActor* Floor = World->SpawnActor<AStaticMeshActor>(FVector(0.f, 0.f, -50.f), FRotator::ZeroRotator);
+	Floor->SetMobility(EComponentMobility::Movable);
+	Floor->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+	Floor->SetActorScale3D(FVector(100.f, 100.f, 1.f));
+
+	// Walls and Ceiling Close the Arena, so Bots and Shot Props Never Reach KillZ during Long Runs.
+	// 5 m Thick so Props Shot at Full Power do not Tunnel Through in One Physics Step
+	const float HalfSize = ArenaHalfSize;
+	const float Thickness = 500.f;
+	const float Height = 5000.f;
+	const FVector WallLocations[] =
+	{
+		FVector(HalfSize + Thickness * 0.5f, 0.f, Height * 0.5f),
+		FVector(-HalfSize - Thickness * 0.5f, 0.f, Height * 0.5f),
+		FVector(0.f, HalfSize + Thickness * 0.5f, Height * 0.5f),
+		FVector(0.f, -HalfSize - Thickness * 0.5f, Height * 0.5f),
+		FVector(0.f, 0.f, Height + Thickness * 0.5f),
+	};
+	const FVector WallScales[] =
+	{
+		FVector(Thickness, HalfSize * 2.f + Thickness * 2.f, Height) / 100.f,
+		FVector(Thickness, HalfSize * 2.f + Thickness * 2.f, Height) / 100.f,
+		FVector(HalfSize * 2.f, Thickness, Height) / 100.f,
+		FVector(HalfSize * 2.f, Thickness, Height) / 100.f,
+		FVector(HalfSize * 2.f + Thickness * 2.f, HalfSize * 2.f + Thickness * 2.f, Thickness) / 100.f,
+	};
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(WallLocations); ++Index)
+	{
+		AStaticMeshActor* Wall = World->SpawnActor<AStaticMeshActor>(WallLocations[Index], FRotator::ZeroRotator);
+		Wall->SetMobility(EComponentMobility::Movable);
+		Wall->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+		Wall->SetActorScale3D(WallScales[Index]);
+	}
+
+	// Props Scattered in a Ring, Using the PhysicsActor Profile so the Gravity Gun Trace Finds them
+	const float RingRadius = GetPropRingRadius(NumProps);
+	if (RingRadius * 2.f * PI / FMath::Max(NumProps, 1) < PropSpacing)
+	{
+		UE_LOG(LogHeadlessWorld, Warning, TEXT("%d props do not fit the arena apart, they will push each other while settling"), NumProps);
+	}
+	for (int32 Index = 0; Index < NumProps; ++Index)
+	{
+		const float Angle = 2.f * PI * Index / FMath::Max(NumProps, 1);
+		const FVector Location(FMath::Cos(Angle) * RingRadius, FMath::Sin(Angle) * RingRadius, 50.f);
+		AStaticMeshActor* Prop = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator);
+		Prop->SetMobility(EComponentMobility::Movable);
+		UStaticMeshComponent* PropMesh = Prop->GetStaticMeshComponent();
+		PropMesh->SetStaticMesh(CubeMesh);
+		PropMesh->SetCollisionProfileName(TEXT("PhysicsActor"));
+		PropMesh->SetSimulatePhysics(true);
+		Prop->SetActorScale3D(FVector(0.5f));
+	}
+}
+
+AStreamlineTestBotController* StreamlineTestHeadlessWorld::SpawnBot(UWorld* World, int32 Seed, const FVector& Location)
+{
+	AStreamlineTestBotController* Bot = World->SpawnActor<AStreamlineTestBotController>();
+	Bot->SetSeed(Seed);
+	if (!RespawnBot(Bot, Location))
+	{
+		Bot->Destroy();
+		return nullptr;
+	}
+	return Bot;
+}
+
+bool StreamlineTestHeadlessWorld::RespawnBot(AStreamlineTestBotController* Bot, const FVector& Location)
+{
+	// Prefer the Game Mode's Pawn so Blueprint Assets (Sounds, Meshes) are Exercised too
+	UWorld* World = Bot->GetWorld();
+	const AGameModeBase* GameMode = World->GetAuthGameMode();
+	UClass* PawnClass = GameMode ? GameMode->DefaultPawnClass.Get() : nullptr;
+	if (PawnClass == nullptr || !PawnClass->IsChildOf(AStreamlineTestCharacter::StaticClass()))
+	{
+		PawnClass = AStreamlineTestCharacter::StaticClass();
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	APawn* Pawn = World->SpawnActor<APawn>(PawnClass, Location, FRotator::ZeroRotator, SpawnParams);
+	if (Pawn == nullptr)
+	{
+		return false;
+	}
+	Bot->Possess(Pawn);
+	return true;
+}
+
+void StreamlineTestHeadlessWorld::Tick(UWorld* World, float DeltaSeconds)
+{
+	FApp::SetDeltaTime(DeltaSeconds);
+	FApp::SetCurrentTime(FApp::GetCurrentTime() + DeltaSeconds);
+
+	FCoreDelegates::OnBeginFrame.Broadcast();
+	World->Tick(LEVELTICK_All, DeltaSeconds);
+	FTicker::GetCoreTicker().Tick(DeltaSeconds);
+	FCoreDelegates::OnEndFrame.Broadcast();
+	++GFrameCounter;
+}
+
+void StreamlineTestHeadlessWorld::Destroy(UWorld* World)
+{
+	UGameInstance* GameInstance = World->GetGameInstance();
+	World->BeginTearingDown();
+	if (GameInstance != nullptr)
+	{
+		GameInstance->Shutdown();
+		GameInstance->RemoveFromRoot();
+	}
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
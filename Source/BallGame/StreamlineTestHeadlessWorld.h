@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+class AStreamlineTestBotController;
+
+/**
+ * Helpers to run the gameplay module without a viewport, for commandlets started with -nullrhi.
+ * The world is ticked manually with a fixed delta, the way the engine loop would tick it.
+ */
+namespace StreamlineTestHeadlessWorld
+{
+	/**
+	 * Creates a game world and begins play in it.
+	 * @param MapName	Long package name of the map to load, or empty to create an arena with a floor and physics props
+	 * @param bListen	Whether the world should listen for client connections
+	 * @returns the world, or nullptr if the map could not be loaded
+	 */
+	UWorld* Create(const FString& MapName, bool bListen = false);
+
+	/** Spawns a floor closed by walls and a ceiling, and NumProps physics cubes that can be grabbed and shot */
+	void SpawnArena(UWorld* World, int32 NumProps);
+
+	/** Radius of the ring SpawnArena places its props on, it grows with the count so props spawn apart */
+	float GetPropRingRadius(int32 NumProps);
+
+	/** Spawns a character of the game mode's pawn class possessed by a seeded bot */
+	AStreamlineTestBotController* SpawnBot(UWorld* World, int32 Seed, const FVector& Location);
+
+	/** Spawns a new pawn for a bot that lost its own, the bot keeps its random stream. Returns false if the pawn could not spawn */
+	bool RespawnBot(AStreamlineTestBotController* Bot, const FVector& Location);
+
+	/** Advances the world and the core ticker by one frame */
+	void Tick(UWorld* World, float DeltaSeconds);
+
+	/** Ends play and releases the world */
+	void Destroy(UWorld* World);
+}
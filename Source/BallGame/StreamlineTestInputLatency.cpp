@@ -0,0 +1,178 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StreamlineTestInputLatency.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogInputLatency, Log, All);
+
+namespace
+{
+	int32 GInputLatencyEnabled = 0;
+	FAutoConsoleVariableRef CVarInputLatencyEnabled(
+		TEXT("BallGame.InputLatency"),
+		GInputLatencyEnabled,
+		TEXT("Traces latency from input handlers to applied movement, launch, impulse and sound.\n")
+		TEXT("0: off (default), 1: on"));
+
+	// Upper Bounds of the Millisecond Buckets, Last Bucket Takes Everything Above
+	const double LatencyBucketBoundsMs[] = { 1.0, 2.0, 4.0, 8.0, 16.7, 33.3, 50.0, 100.0, 200.0 };
+	const int32 NumLatencyBuckets = UE_ARRAY_COUNT(LatencyBucketBoundsMs) + 1;
+	// Frame Buckets: 0, 1, 2, 3 and 4+ Frames Between Input and Effect
+	const int32 NumFrameBuckets = 5;
+
+	struct FLatencyHistogram
+	{
+		int32 Buckets[NumLatencyBuckets] = {};
+		int32 FrameBuckets[NumFrameBuckets] = {};
+		int32 Count = 0;
+		double SumMs = 0.0;
+		double MinMs = 0.0;
+		double MaxMs = 0.0;
+
+		void Add(double Ms, uint64 Frames)
+		{
+			int32 Bucket = 0;
+			while (Bucket < NumLatencyBuckets - 1 && Ms > LatencyBucketBoundsMs[Bucket])
+			{
+				++Bucket;
+			}
+			++Buckets[Bucket];
+			++FrameBuckets[FMath::Min<uint64>(Frames, NumFrameBuckets - 1)];
+			MinMs = Count ? FMath::Min(MinMs, Ms) : Ms;
+			MaxMs = FMath::Max(MaxMs, Ms);
+			SumMs += Ms;
+			++Count;
+		}
+	};
+
+	FLatencyHistogram Histograms[(int32)EStreamlineInputAction::Count][(int32)EStreamlineInputEffect::Count];
+
+	const TCHAR* GetActionName(int32 Action)
+	{
+		static const TCHAR* Names[] = { TEXT("Move"), TEXT("Jet"), TEXT("Dash"), TEXT("Grab"), TEXT("Fire") };
+		static_assert(UE_ARRAY_COUNT(Names) == (int32)EStreamlineInputAction::Count, "Missing input action name");
+		return Names[Action];
+	}
+
+	const TCHAR* GetEffectName(int32 Effect)
+	{
+		static const TCHAR* Names[] = { TEXT("Movement"), TEXT("Launch"), TEXT("Impulse"), TEXT("Sound") };
+		static_assert(UE_ARRAY_COUNT(Names) == (int32)EStreamlineInputEffect::Count, "Missing input effect name");
+		return Names[Effect];
+	}
+
+	FAutoConsoleCommand DumpInputLatencyCommand(
+		TEXT("BallGame.InputLatency.Dump"),
+		TEXT("Logs input latency histograms and writes them as CSV to Saved/Profiling/InputLatency."),
+		FConsoleCommandDelegate::CreateStatic(&FStreamlineInputLatencyTracker::DumpHistograms));
+
+	FAutoConsoleCommand ResetInputLatencyCommand(
+		TEXT("BallGame.InputLatency.Reset"),
+		TEXT("Clears recorded input latency histograms."),
+		FConsoleCommandDelegate::CreateStatic(&FStreamlineInputLatencyTracker::ResetHistograms));
+}
+
+void FStreamlineInputLatencyTracker::MarkInput(EStreamlineInputAction Action)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+	const int32 Index = (int32)Action;
+	InputCycles[Index] = FPlatformTime::Cycles64();
+	InputFrames[Index] = GFrameCounter;
+	RecordedEffects[Index] = 0;
+}
+
+void FStreamlineInputLatencyTracker::MarkApplied(EStreamlineInputAction Action, EStreamlineInputEffect Effect)
+{
+	const int32 Index = (int32)Action;
+	const uint8 EffectBit = 1 << (int32)Effect;
+	if (InputCycles[Index] == 0 || (RecordedEffects[Index] & EffectBit))
+	{
+		return;
+	}
+	RecordedEffects[Index] |= EffectBit;
+
+	const double Ms = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - InputCycles[Index]);
+	Histograms[Index][(int32)Effect].Add(Ms, GFrameCounter - InputFrames[Index]);
+}
+
+void FStreamlineInputLatencyTracker::Clear(EStreamlineInputAction Action)
+{
+	InputCycles[(int32)Action] = 0;
+	RecordedEffects[(int32)Action] = 0;
+}
+
+bool FStreamlineInputLatencyTracker::IsEnabled()
+{
+	return GInputLatencyEnabled != 0;
+}
+
+void FStreamlineInputLatencyTracker::ResetHistograms()
+{
+	for (auto& ActionHistograms : Histograms)
+	{
+		for (FLatencyHistogram& Histogram : ActionHistograms)
+		{
+			Histogram = FLatencyHistogram();
+		}
+	}
+}
+
+void FStreamlineInputLatencyTracker::DumpHistograms()
+{
+	FString Csv = TEXT("Action,Effect,Count,AvgMs,MinMs,MaxMs");
+	for (int32 Bucket = 0; Bucket < NumLatencyBuckets; ++Bucket)
+	{
+		Csv += Bucket < NumLatencyBuckets - 1
+			? FString::Printf(TEXT(",<=%.1fms"), LatencyBucketBoundsMs[Bucket])
+			: FString::Printf(TEXT(",>%.1fms"), LatencyBucketBoundsMs[Bucket - 1]);
+	}
+	for (int32 Frames = 0; Frames < NumFrameBuckets; ++Frames)
+	{
+		Csv += FString::Printf(Frames < NumFrameBuckets - 1 ? TEXT(",%dFrames") : TEXT(",%d+Frames"), Frames);
+	}
+	Csv += LINE_TERMINATOR;
+
+	for (int32 Action = 0; Action < (int32)EStreamlineInputAction::Count; ++Action)
+	{
+		for (int32 Effect = 0; Effect < (int32)EStreamlineInputEffect::Count; ++Effect)
+		{
+			const FLatencyHistogram& Histogram = Histograms[Action][Effect];
+			if (Histogram.Count == 0)
+			{
+				continue;
+			}
+			const double AvgMs = Histogram.SumMs / Histogram.Count;
+			UE_LOG(LogInputLatency, Log, TEXT("%s -> %s: %d samples, avg %.2f ms, min %.2f ms, max %.2f ms, same frame %d, next frame %d, later %d"),
+				GetActionName(Action), GetEffectName(Effect), Histogram.Count, AvgMs, Histogram.MinMs, Histogram.MaxMs,
+				Histogram.FrameBuckets[0], Histogram.FrameBuckets[1], Histogram.Count - Histogram.FrameBuckets[0] - Histogram.FrameBuckets[1]);
+
+			Csv += FString::Printf(TEXT("%s,%s,%d,%.3f,%.3f,%.3f"), GetActionName(Action), GetEffectName(Effect), Histogram.Count, AvgMs, Histogram.MinMs, Histogram.MaxMs);
+			for (int32 Count : Histogram.Buckets)
+			{
+				Csv += FString::Printf(TEXT(",%d"), Count);
+			}
+			for (int32 Count : Histogram.FrameBuckets)
+			{
+				Csv += FString::Printf(TEXT(",%d"), Count);
+			}
+			Csv += LINE_TERMINATOR;
+		}
+	}
+
+	const FString CsvPath = FPaths::ProfilingDir() / TEXT("InputLatency") / FString::Printf(TEXT("InputLatency-%s.csv"), *FDateTime::Now().ToString());
+	if (FFileHelper::SaveStringToFile(Csv, *CsvPath))
+	{
+		UE_LOG(LogInputLatency, Log, TEXT("Input latency histograms written to %s"), *CsvPath);
+	}
+	else
+	{
+		UE_LOG(LogInputLatency, Warning, TEXT("Failed to write input latency histograms to %s"), *CsvPath);
+	}
+}
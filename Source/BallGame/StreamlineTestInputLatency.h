@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Input Actions Traced from their Bound Handler to their Applied Effect
+enum class EStreamlineInputAction : uint8
+{
+	Move,
+	Jet,
+	Dash,
+	Grab,
+	Fire,
+	Count
+};
+
+// Effects an Input Action Ends With
+enum class EStreamlineInputEffect : uint8
+{
+	// AddMovementInput or Dash Location Update
+	Movement,
+	// LaunchCharacter
+	Launch,
+	// Impulse or Constraint Applied to Physics Body
+	Impulse,
+	// Sound Started
+	Sound,
+	Count
+};
+
+/**
+ * Per-Character Input Latency Tracker.
+ * MarkInput() stamps the time an action arrives in its bound handler, MarkApplied() closes the
+ * stamp for one effect and feeds the shared per-action histograms. Each effect is recorded once per input.
+ * Disabled by default, enable with "BallGame.InputLatency 1" and export with "BallGame.InputLatency.Dump".
+ */
+class FStreamlineInputLatencyTracker
+{
+public:
+	/** Stamps the arrival of an input action, restarting any pending stamp for it */
+	void MarkInput(EStreamlineInputAction Action);
+
+	/** Records the latency between the pending input stamp and the applied effect */
+	void MarkApplied(EStreamlineInputAction Action, EStreamlineInputEffect Effect);
+
+	/** Drops the pending stamp of an action whose input did not lead to any effect */
+	void Clear(EStreamlineInputAction Action);
+
+	/** Returns true if the action has a stamp waiting for an effect */
+	bool IsPending(EStreamlineInputAction Action) const { return InputCycles[(int32)Action] != 0; }
+
+	/** Returns true if latency tracing is enabled */
+	static bool IsEnabled();
+
+	/** Clears all recorded histograms */
+	static void ResetHistograms();
+
+	/** Logs the recorded histograms and writes them as CSV to the profiling directory */
+	static void DumpHistograms();
+
+private:
+	// Cycle Stamp of Each Pending Input (0 if None)
+	uint64 InputCycles[(int32)EStreamlineInputAction::Count] = {};
+	// Frame Number of Each Pending Input
+	uint64 InputFrames[(int32)EStreamlineInputAction::Count] = {};
+	// Effects Already Recorded for Each Pending Input
+	uint8 RecordedEffects[(int32)EStreamlineInputAction::Count] = {};
+};
@@ -0,0 +1,280 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StreamlineTestInstanceBatcher.h"
+#include "BallGame.h"
+#include "StreamlineTestAllocationCounter.h"
+#include "StreamlineTestCharacter.h"
+#include "StreamlineTestFrameArena.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "Materials/MaterialInterface.h"
+
+DECLARE_CYCLE_STAT(TEXT("Instance Batcher Tick"), STAT_InstanceBatcherTick, STATGROUP_BallGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Instanced Batches"), STAT_InstancedBatches, STATGROUP_BallGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Batched Components"), STAT_BatchedComponents, STATGROUP_BallGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Moved Instances"), STAT_MovedInstances, STATGROUP_BallGame);
+
+AStreamlineTestInstanceBatcher::AStreamlineTestInstanceBatcher()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	// Run after Physics so Bodies that Woke Up this Frame are Handed Back Right Away
+	PrimaryActorTick.TickGroup = TG_PostPhysics;
+
+	// Batches Use World Space Instances, so the Root Stays at the Origin
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void AStreamlineTestInstanceBatcher::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_InstanceBatcherTick);
+	STREAMLINE_TICK_ALLOCATION_SCOPE();
+	Super::Tick(DeltaTime);
+
+	// Controller List is Walked in Place, Unlike Actor Iterators it does not Allocate
+	HeldComponents.Reset();
+	for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
+	{
+		const AStreamlineTestCharacter* Character = It->IsValid() ? Cast<AStreamlineTestCharacter>((*It)->GetPawn()) : nullptr;
+		if (const UPrimitiveComponent* Held = Character ? Character->GetGrabedObject() : nullptr)
+		{
+			HeldComponents.Add(Held);
+		}
+	}
+
+	for (auto It = Batches.CreateIterator(); It; ++It)
+	{
+		FBatch& Batch = It.Value();
+		UpdateBatch(It.Key(), Batch);
+
+		// Too Few Sources Left to be Worth a Batch
+		if (Batch.Sources.Num() < MinBatchSize)
+		{
+			// Destroying the Batch Component is Engine Work, like Creating and Rebuilding One
+			STREAMLINE_TICK_ALLOCATION_EXEMPT();
+			for (const TWeakObjectPtr<UStaticMeshComponent>& Source : Batch.Sources)
+			{
+				if (UStaticMeshComponent* Component = Source.Get())
+				{
+					ReleaseSource(Component);
+				}
+				BatchedComponents.Remove(Source);
+			}
+			BatchComponents.Remove(Batch.Instances);
+			Batch.Instances->DestroyComponent();
+			It.RemoveCurrent();
+		}
+	}
+
+	ScanCountdown -= DeltaTime;
+	if (ScanCountdown <= 0.f)
+	{
+		ScanCountdown = ScanInterval;
+		ScanForCandidates();
+	}
+
+	for (auto& Pair : Batches)
+	{
+		if (Pair.Value.bRebuild)
+		{
+			// Only when Bodies Fell Asleep, Woke Up or were Grabbed, and Reallocates the Engine's Instance Data
+			STREAMLINE_TICK_ALLOCATION_EXEMPT();
+			RebuildBatch(Pair.Value);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_InstancedBatches, Batches.Num());
+	SET_DWORD_STAT(STAT_BatchedComponents, BatchedComponents.Num());
+}
+
+void AStreamlineTestInstanceBatcher::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (const TWeakObjectPtr<UStaticMeshComponent>& Source : BatchedComponents)
+	{
+		if (UStaticMeshComponent* Component = Source.Get())
+		{
+			ReleaseSource(Component);
+		}
+	}
+	BatchedComponents.Reset();
+	Batches.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+bool AStreamlineTestInstanceBatcher::MakeKey(const UStaticMeshComponent* Component, FBatchKey& OutKey)
+{
+	// Subclasses (Instanced Meshes, Splines...) Draw Differently, Pawns Own their Cosmetic Parts
+	if (Component->GetClass() != UStaticMeshComponent::StaticClass() || Component->GetStaticMesh() == nullptr)
+	{
+		return false;
+	}
+	// Static and Stationary Geometry would Lose its Baked Lighting when Drawn by a Movable Batch
+	if (Component->Mobility != EComponentMobility::Movable)
+	{
+		return false;
+	}
+	const AActor* Owner = Component->GetOwner();
+	if (Owner == nullptr || Owner->IsA<APawn>() || Owner->IsA<AStreamlineTestInstanceBatcher>())
+	{
+		return false;
+	}
+
+	OutKey.Mesh = Component->GetStaticMesh();
+	OutKey.Materials.Reset();
+	for (int32 Index = 0; Index < Component->GetNumMaterials(); ++Index)
+	{
+		OutKey.Materials.Add(Component->GetMaterial(Index));
+	}
+	OutKey.bCastShadow = Component->CastShadow;
+	return true;
+}
+
+bool AStreamlineTestInstanceBatcher::IsBatchable(const UStaticMeshComponent* Component) const
+{
+	if (!Component->IsRegistered() || Component->bHiddenInGame || Component->GetOwner()->IsHidden() || HeldComponents.Contains(Component))
+	{
+		return false;
+	}
+	// Only Physics Bodies at Rest. Moving Ones, and Meshes Moved by Gameplay without Physics, would
+	// Update their Instance Every Frame without Ever being Handed Back
+	return Component->IsSimulatingPhysics() && !Component->RigidBodyIsAwake();
+}
+
+void AStreamlineTestInstanceBatcher::ScanForCandidates()
+{
+	// Scratch Data Lives on the Frame Arena, Scans Leave no Heap Allocations Behind
+	typedef TArray<UStaticMeshComponent*, TStreamlineFrameArenaAllocator<>> FCandidateArray;
+	TMap<FBatchKey, FCandidateArray, FStreamlineFrameArenaSetAllocator> Candidates;
+	for (ULevel* Level : GetWorld()->GetLevels())
+	{
+		for (AActor* Actor : Level->Actors)
+		{
+			if (Actor == nullptr || Actor->IsPendingKill())
+			{
+				continue;
+			}
+			Actor->ForEachComponent<UStaticMeshComponent>(false, [this, &Candidates](UStaticMeshComponent* Component)
+			{
+				FBatchKey Key;
+				// Hidden Components are Either Batched Already or Hidden by Gameplay
+				if (Component->IsVisible() && MakeKey(Component, Key) && IsBatchable(Component))
+				{
+					Candidates.FindOrAdd(MoveTemp(Key)).Add(Component);
+				}
+			});
+		}
+	}
+
+	// Candidates Above are Gathered on the Frame Arena Every Scan. Joining Batches Happens Only when
+	// Bodies Come to Rest, it Grows Batch Arrays and Creates Batch Components like a Rebuild does
+	for (auto& Pair : Candidates)
+	{
+		STREAMLINE_TICK_ALLOCATION_EXEMPT();
+		FBatch* Batch = Batches.Find(Pair.Key);
+		if (Batch == nullptr)
+		{
+			if (Pair.Value.Num() < MinBatchSize)
+			{
+				continue;
+			}
+			Batch = &Batches.Add(Pair.Key);
+			Batch->Instances = CreateBatchComponent(Pair.Key);
+		}
+
+		for (UStaticMeshComponent* Component : Pair.Value)
+		{
+			Batch->Sources.Add(Component);
+			Batch->Transforms.Add(Component->GetComponentTransform());
+			BatchedComponents.Add(Component);
+			Component->SetVisibility(false);
+		}
+		Batch->bRebuild = true;
+	}
+}
+
+void AStreamlineTestInstanceBatcher::UpdateBatch(const FBatchKey& Key, FBatch& Batch)
+{
+	bool bMoved = false;
+	FBatchKey SourceKey;
+	// Reverse Order so Swapped in Sources are Already Checked
+	for (int32 Index = Batch.Sources.Num() - 1; Index >= 0; --Index)
+	{
+		UStaticMeshComponent* Component = Batch.Sources[Index].Get();
+		// A Source Shown Again or Given a New Mesh or Material by Gameplay Draws Itself
+		if (Component == nullptr || Component->IsVisible() || !MakeKey(Component, SourceKey) || !(SourceKey == Key) || !IsBatchable(Component))
+		{
+			if (Component != nullptr)
+			{
+				ReleaseSource(Component);
+			}
+			BatchedComponents.Remove(Batch.Sources[Index]);
+			Batch.Sources.RemoveAtSwap(Index);
+			Batch.Transforms.RemoveAtSwap(Index);
+			Batch.bRebuild = true;
+			continue;
+		}
+
+		// Only Bodies that Moved Since Last Frame Touch their Instance
+		const FTransform& Transform = Component->GetComponentTransform();
+		if (!Transform.Equals(Batch.Transforms[Index]))
+		{
+			Batch.Transforms[Index] = Transform;
+			if (!Batch.bRebuild)
+			{
+				Batch.Instances->UpdateInstanceTransform(Index, Transform, true, false, true);
+				bMoved = true;
+				INC_DWORD_STAT(STAT_MovedInstances);
+			}
+		}
+	}
+
+	if (bMoved && !Batch.bRebuild)
+	{
+		Batch.Instances->MarkRenderStateDirty();
+	}
+}
+
+void AStreamlineTestInstanceBatcher::RebuildBatch(FBatch& Batch)
+{
+	Batch.Instances->ClearInstances();
+	for (const FTransform& Transform : Batch.Transforms)
+	{
+		Batch.Instances->AddInstanceWorldSpace(Transform);
+	}
+	Batch.bRebuild = false;
+}
+
+void AStreamlineTestInstanceBatcher::ReleaseSource(UStaticMeshComponent* Component)
+{
+	// Sources were Visible when Batched, Undo Only the Batcher's Own Hiding. Hidden in Game and
+	// Hidden Actors are Left to Gameplay, and a Source Shown Again by Gameplay is Already Visible
+	if (!Component->IsVisible())
+	{
+		Component->SetVisibility(true);
+	}
+}
+
+UHierarchicalInstancedStaticMeshComponent* AStreamlineTestInstanceBatcher::CreateBatchComponent(const FBatchKey& Key)
+{
+	UHierarchicalInstancedStaticMeshComponent* Instances = NewObject<UHierarchicalInstancedStaticMeshComponent>(this);
+	Instances->SetupAttachment(RootComponent);
+	Instances->SetMobility(EComponentMobility::Movable);
+	Instances->SetStaticMesh(Key.Mesh);
+	for (int32 Index = 0; Index < Key.Materials.Num(); ++Index)
+	{
+		Instances->SetMaterial(Index, Key.Materials[Index]);
+	}
+	Instances->SetCastShadow(Key.bCastShadow);
+	// Sources Keep their Collision, the Batch is Drawing Only
+	Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Instances->SetCanEverAffectNavigation(false);
+	Instances->RegisterComponent();
+	AddInstanceComponent(Instances);
+	BatchComponents.Add(Instances);
+	return Instances;
+}
@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "StreamlineTestInstanceBatcher.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+class UStaticMeshComponent;
+
+/**
+ * Draws visually identical static mesh components (same mesh, materials and shadow settings) as
+ * hierarchical instanced batches. Only movable physics bodies that are asleep and not held are batched,
+ * so level geometry keeps its baked lighting and meshes moved without physics keep drawing themselves.
+ * Batched components are hidden but keep colliding and simulating. A batched body that wakes up or gets
+ * grabbed is handed back to its own component on the next tick, and so is one whose mesh or materials change. The batcher hides sources with SetVisibility, so gameplay should hide
+ * batched props with SetHiddenInGame or SetActorHiddenInGame, which are kept when a source is handed back.
+ * Spawned by AStreamlineTestHUD, so only worlds that render get one (toggle with BallGame.InstancedProps).
+ */
+UCLASS()
+class AStreamlineTestInstanceBatcher : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AStreamlineTestInstanceBatcher();
+
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the number of instanced batches currently drawn */
+	int32 GetNumBatches() const { return Batches.Num(); }
+
+	/** Returns the number of components drawn through instanced batches */
+	int32 GetNumBatchedComponents() const { return BatchedComponents.Num(); }
+
+	// Seconds Between Two Scans of the World for New Candidates
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Instancing")
+	float ScanInterval = 0.5f;
+	// Min Number of Identical Components Needed to Form a Batch
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Instancing")
+	int32 MinBatchSize = 2;
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	// What Makes Two Components Visually Identical
+	struct FBatchKey
+	{
+		UStaticMesh* Mesh = nullptr;
+		TArray<UMaterialInterface*, TInlineAllocator<4>> Materials;
+		bool bCastShadow = false;
+
+		bool operator==(const FBatchKey& Other) const
+		{
+			return Mesh == Other.Mesh && Materials == Other.Materials && bCastShadow == Other.bCastShadow;
+		}
+		friend uint32 GetTypeHash(const FBatchKey& Key)
+		{
+			uint32 Hash = HashCombine(GetTypeHash(Key.Mesh), GetTypeHash(Key.bCastShadow));
+			for (UMaterialInterface* Material : Key.Materials)
+			{
+				Hash = HashCombine(Hash, GetTypeHash(Material));
+			}
+			return Hash;
+		}
+	};
+
+	struct FBatch
+	{
+		UHierarchicalInstancedStaticMeshComponent* Instances = nullptr;
+		// Source Component of Each Instance, Same Order as the Instances
+		TArray<TWeakObjectPtr<UStaticMeshComponent>> Sources;
+		// World Transform of Each Instance as Last Sent to the Batch
+		TArray<FTransform> Transforms;
+		// Set when Sources Changed and Instances have to be Rebuilt
+		bool bRebuild = false;
+	};
+
+	// Builds the Key of a Component, Returns false if it can Never be Batched
+	static bool MakeKey(const UStaticMeshComponent* Component, FBatchKey& OutKey);
+	// Whether a Component can be Drawn by a Batch Right Now
+	bool IsBatchable(const UStaticMeshComponent* Component) const;
+	// Finds New Candidates and Adds them to Existing or New Batches
+	void ScanForCandidates();
+	// Drops Sources that are Gone, Changed Look or are no Longer Batchable and Updates Moved Instances
+	void UpdateBatch(const FBatchKey& Key, FBatch& Batch);
+	// Recreates all Instances of a Batch from its Sources
+	void RebuildBatch(FBatch& Batch);
+	// Gives a Source its Own Rendering Back
+	void ReleaseSource(UStaticMeshComponent* Component);
+	UHierarchicalInstancedStaticMeshComponent* CreateBatchComponent(const FBatchKey& Key);
+
+	TMap<FBatchKey, FBatch> Batches;
+	// All Sources Currently Drawn by a Batch
+	TSet<TWeakObjectPtr<UStaticMeshComponent>> BatchedComponents;
+	// Components Grabbed by a Gravity Gun this Tick
+	TSet<const UPrimitiveComponent*> HeldComponents;
+
+	// Keeps Batch Components Referenced
+	UPROPERTY(Transient)
+	TArray<UHierarchicalInstancedStaticMeshComponent*> BatchComponents;
+
+	float ScanCountdown = 0.f;
+};
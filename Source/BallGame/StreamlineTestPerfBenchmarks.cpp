@@ -0,0 +1,436 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StreamlineTestPerfBenchmarks.h"
+#include "StreamlineTestBotController.h"
+#include "StreamlineTestCharacter.h"
+#include "StreamlineTestHeadlessWorld.h"
+#include "StreamlineTestHUD.h"
+#include "StreamlineTestProjectile.h"
+#include "CanvasTypes.h"
+#include "Camera/CameraComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Canvas.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "GameFramework/SaveGame.h"
+#include "HAL/PlatformProperties.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UnrealClient.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPerfBenchmarks, Log, All);
+
+using namespace StreamlineTestPerfBenchmarks;
+
+namespace
+{
+	// Render Target with Nothing Behind it, the Canvas Only Batches Draw Calls into it
+	class FPerfRenderTarget : public FRenderTarget
+	{
+	public:
+		explicit FPerfRenderTarget(const FIntPoint& InSize) : Size(InSize) {}
+		virtual FIntPoint GetSizeXY() const override { return Size; }
+
+	private:
+		FIntPoint Size;
+	};
+
+	double Mean(const TArray<double>& Values)
+	{
+		double Sum = 0.0;
+		for (double Value : Values)
+		{
+			Sum += Value;
+		}
+		return Values.Num() > 0 ? Sum / Values.Num() : 0.0;
+	}
+
+	double Percentile(TArray<double> Values, double Fraction)
+	{
+		if (Values.Num() == 0)
+		{
+			return 0.0;
+		}
+		Values.Sort();
+		return Values[FMath::Clamp(FMath::CeilToInt(Fraction * Values.Num()) - 1, 0, Values.Num() - 1)];
+	}
+
+	// Frame Times in Milliseconds of NumFrames Fixed Delta Ticks
+	void TickFrames(UWorld* World, const FSettings& Settings, int32 NumFrames, TArray<double>* OutFrameMs = nullptr)
+	{
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const double Start = FPlatformTime::Seconds();
+			StreamlineTestHeadlessWorld::Tick(World, Settings.DeltaTime);
+			if (OutFrameMs != nullptr)
+			{
+				OutFrameMs->Add((FPlatformTime::Seconds() - Start) * 1000.0);
+			}
+		}
+	}
+
+	// Whole World Tick with Many Bot Driven Characters Moving, Jetting, Dashing, Grabbing and Firing
+	bool RunCharacterTick(const FSettings& Settings, FResults& OutResults)
+	{
+		UWorld* World = StreamlineTestHeadlessWorld::Create(FString());
+		if (World == nullptr)
+		{
+			return false;
+		}
+		StreamlineTestHeadlessWorld::SpawnArena(World, 32);
+
+		const int32 GridSize = FMath::CeilToInt(FMath::Sqrt((float)Settings.NumCharacters));
+		for (int32 Index = 0; Index < Settings.NumCharacters; ++Index)
+		{
+			const FVector Location((Index % GridSize - GridSize / 2) * 300.f, (Index / GridSize - GridSize / 2) * 300.f, 200.f);
+			StreamlineTestHeadlessWorld::SpawnBot(World, Index + 1, Location);
+		}
+
+		// Let the Characters Land before Measuring
+		TickFrames(World, Settings, 60);
+		TArray<double> FrameMs;
+		FrameMs.Reserve(Settings.NumFrames);
+		TickFrames(World, Settings, Settings.NumFrames, &FrameMs);
+		StreamlineTestHeadlessWorld::Destroy(World);
+
+		OutResults.Metrics.Add(TEXT("AvgFrameMs"), Mean(FrameMs));
+		OutResults.Metrics.Add(TEXT("P95FrameMs"), Percentile(FrameMs, 0.95));
+		return true;
+	}
+
+	// Projectiles Fired Outwards at a Ring of Physics Props, Spawn Cost and Frame Cost while they Fly and Hit
+	bool RunProjectileThroughput(const FSettings& Settings, FResults& OutResults)
+	{
+		UWorld* World = StreamlineTestHeadlessWorld::Create(FString());
+		if (World == nullptr)
+		{
+			return false;
+		}
+		StreamlineTestHeadlessWorld::SpawnArena(World, Settings.NumProjectiles);
+		// Let the Props Settle on the Floor
+		TickFrames(World, Settings, 30);
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		TArray<TWeakObjectPtr<AStreamlineTestProjectile>> Projectiles;
+		Projectiles.Reserve(Settings.NumProjectiles);
+		const double SpawnStart = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Settings.NumProjectiles; ++Index)
+		{
+			// Same Angles as the Arena Props, so Every Projectile has a Prop to Hit
+			const float Angle = 2.f * PI * Index / FMath::Max(Settings.NumProjectiles, 1);
+			const FVector Location(FMath::Cos(Angle) * 800.f, FMath::Sin(Angle) * 800.f, 25.f);
+			AStreamlineTestProjectile* Projectile = World->SpawnActor<AStreamlineTestProjectile>(Location, FRotator(0.f, FMath::RadiansToDegrees(Angle), 0.f), SpawnParams);
+			if (Projectile == nullptr)
+			{
+				continue;
+			}
+			// Straight Flight so the Hit Count does not Depend on Floor Bounces
+			Projectile->GetProjectileMovement()->ProjectileGravityScale = 0.f;
+			Projectiles.Add(Projectile);
+		}
+		const double SpawnMs = (FPlatformTime::Seconds() - SpawnStart) * 1000.0;
+
+		// Long Enough to Reach the Ring with Half a Second to Spare, Short of the Projectile Life Span
+		const float ProjectileSpeed = GetDefault<AStreamlineTestProjectile>()->GetProjectileMovement()->InitialSpeed;
+		const float FlightSeconds = (StreamlineTestHeadlessWorld::GetPropRingRadius(Settings.NumProjectiles) - 800.f) / ProjectileSpeed + 0.5f;
+		TArray<double> FrameMs;
+		TickFrames(World, Settings, FMath::CeilToInt(FlightSeconds / Settings.DeltaTime), &FrameMs);
+		int32 NumHits = 0;
+		for (const TWeakObjectPtr<AStreamlineTestProjectile>& Projectile : Projectiles)
+		{
+			NumHits += Projectile.IsValid() && !Projectile->IsPendingKill() ? 0 : 1;
+		}
+		StreamlineTestHeadlessWorld::Destroy(World);
+
+		OutResults.Counts.Add(TEXT("Projectiles"), Projectiles.Num());
+		OutResults.Counts.Add(TEXT("Hits"), NumHits);
+		// Frames without Hits are Cheaper, so Broken Collision would Otherwise Read as a Speedup
+		if (NumHits == 0)
+		{
+			UE_LOG(LogPerfBenchmarks, Error, TEXT("None of the %d projectiles hit a prop"), Projectiles.Num());
+			return false;
+		}
+		OutResults.Metrics.Add(TEXT("SpawnMsPerProjectile"), SpawnMs / FMath::Max(Settings.NumProjectiles, 1));
+		OutResults.Metrics.Add(TEXT("AvgFrameMs"), Mean(FrameMs));
+		return true;
+	}
+
+	// Gravity Gun Trace, Grab and Fire Against a Floating Prop in Front of the Character
+	bool RunGrabFireTrace(const FSettings& Settings, FResults& OutResults)
+	{
+		UWorld* World = StreamlineTestHeadlessWorld::Create(FString());
+		if (World == nullptr)
+		{
+			return false;
+		}
+		StreamlineTestHeadlessWorld::SpawnArena(World, 0);
+		AStreamlineTestBotController* Bot = StreamlineTestHeadlessWorld::SpawnBot(World, 1, FVector(0.f, 0.f, 200.f));
+		AStreamlineTestCharacter* Character = Bot ? Cast<AStreamlineTestCharacter>(Bot->GetPawn()) : nullptr;
+		UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+		if (Character == nullptr || CubeMesh == nullptr)
+		{
+			UE_LOG(LogPerfBenchmarks, Error, TEXT("Could not spawn the character or load the target mesh"));
+			StreamlineTestHeadlessWorld::Destroy(World);
+			return false;
+		}
+		// The Benchmark Drives the Gravity Gun through the Bot, with its Random Actions Off
+		Bot->SetActorTickEnabled(false);
+		TickFrames(World, Settings, 60);
+
+		const UCameraComponent* Camera = Character->GetFirstPersonCameraComponent();
+		const FVector TargetLocation = Camera->GetComponentLocation() + Camera->GetForwardVector() * 400.f;
+		AStaticMeshActor* Target = World->SpawnActor<AStaticMeshActor>(TargetLocation, FRotator::ZeroRotator);
+		Target->SetMobility(EComponentMobility::Movable);
+		UStaticMeshComponent* TargetMesh = Target->GetStaticMeshComponent();
+		TargetMesh->SetStaticMesh(CubeMesh);
+		TargetMesh->SetCollisionProfileName(TEXT("PhysicsActor"));
+		TargetMesh->SetSimulatePhysics(true);
+		TargetMesh->SetEnableGravity(false);
+		Target->SetActorScale3D(FVector(0.5f));
+		TickFrames(World, Settings, 1);
+
+		double TraceSeconds = 0.0;
+		int32 NumTraceHits = 0;
+		for (int32 Iteration = 0; Iteration < Settings.NumIterations; ++Iteration)
+		{
+			FHitResult Hit;
+			const double Start = FPlatformTime::Seconds();
+			NumTraceHits += Bot->TraceGrabTarget(Hit) ? 1 : 0;
+			TraceSeconds += FPlatformTime::Seconds() - Start;
+		}
+		if (NumTraceHits != Settings.NumIterations)
+		{
+			UE_LOG(LogPerfBenchmarks, Error, TEXT("Grab trace missed the target %d times"), Settings.NumIterations - NumTraceHits);
+			StreamlineTestHeadlessWorld::Destroy(World);
+			return false;
+		}
+
+		double GrabSeconds = 0.0;
+		double FireSeconds = 0.0;
+		int32 NumGrabs = 0;
+		for (int32 Iteration = 0; Iteration < Settings.NumIterations; ++Iteration)
+		{
+			const double GrabStart = FPlatformTime::Seconds();
+			Bot->Grab();
+			const double FireStart = FPlatformTime::Seconds();
+			NumGrabs += Character->GetGrabedObject() != nullptr ? 1 : 0;
+			Bot->Fire();
+			FireSeconds += FPlatformTime::Seconds() - FireStart;
+			GrabSeconds += FireStart - GrabStart;
+
+			// Put the Shot Target Back, Outside the Measured Calls
+			TargetMesh->SetWorldLocation(TargetLocation, false, nullptr, ETeleportType::ResetPhysics);
+			TargetMesh->SetPhysicsLinearVelocity(FVector::ZeroVector);
+			TargetMesh->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+			TickFrames(World, Settings, 1);
+		}
+		StreamlineTestHeadlessWorld::Destroy(World);
+
+		OutResults.Counts.Add(TEXT("Grabs"), NumGrabs);
+		if (NumGrabs == 0)
+		{
+			UE_LOG(LogPerfBenchmarks, Error, TEXT("Never grabbed the target in %d tries"), Settings.NumIterations);
+			return false;
+		}
+		if (NumGrabs != Settings.NumIterations)
+		{
+			UE_LOG(LogPerfBenchmarks, Warning, TEXT("Grabbed the target %d of %d times"), NumGrabs, Settings.NumIterations);
+		}
+		const int32 NumIterations = FMath::Max(Settings.NumIterations, 1);
+		OutResults.Metrics.Add(TEXT("TraceMs"), TraceSeconds * 1000.0 / NumIterations);
+		OutResults.Metrics.Add(TEXT("GrabMs"), GrabSeconds * 1000.0 / NumIterations);
+		OutResults.Metrics.Add(TEXT("FireMs"), FireSeconds * 1000.0 / NumIterations);
+		return true;
+	}
+
+	// HUD Draw into a Canvas Backed by a Null Render Target
+	bool RunHudDraw(const FSettings& Settings, FResults& OutResults)
+	{
+		UWorld* World = StreamlineTestHeadlessWorld::Create(FString());
+		if (World == nullptr)
+		{
+			return false;
+		}
+
+		// Prefer the Game Mode's HUD so Blueprint Drawing is Measured too
+		const AGameModeBase* GameMode = World->GetAuthGameMode();
+		UClass* HUDClass = GameMode ? GameMode->HUDClass.Get() : nullptr;
+		if (HUDClass == nullptr || !HUDClass->IsChildOf(AStreamlineTestHUD::StaticClass()))
+		{
+			HUDClass = AStreamlineTestHUD::StaticClass();
+		}
+		AHUD* HUD = World->SpawnActor<AHUD>(HUDClass);
+
+		const FIntPoint Size(1920, 1080);
+		FPerfRenderTarget RenderTarget(Size);
+		TArray<double> DrawMs;
+		DrawMs.Reserve(Settings.NumIterations);
+		{
+			FCanvas CanvasObject(&RenderTarget, nullptr, World, World->FeatureLevel);
+			UCanvas* Canvas = NewObject<UCanvas>(GetTransientPackage());
+			Canvas->Init(Size.X, Size.Y, nullptr, &CanvasObject);
+			Canvas->Update();
+			HUD->Canvas = Canvas;
+			HUD->DebugCanvas = Canvas;
+
+			for (int32 Iteration = 0; Iteration < Settings.NumIterations; ++Iteration)
+			{
+				const double Start = FPlatformTime::Seconds();
+				HUD->DrawHUD();
+				DrawMs.Add((FPlatformTime::Seconds() - Start) * 1000.0);
+			}
+
+			// The Canvas is Never Flushed, its Batches are Dropped with it
+			HUD->Canvas = nullptr;
+			HUD->DebugCanvas = nullptr;
+			Canvas->Canvas = nullptr;
+		}
+		StreamlineTestHeadlessWorld::Destroy(World);
+
+		OutResults.Metrics.Add(TEXT("AvgDrawMs"), Mean(DrawMs));
+		OutResults.Metrics.Add(TEXT("P95DrawMs"), Percentile(DrawMs, 0.95));
+		return true;
+	}
+
+	// Round Trip of the Game's Save Object through a Save Slot
+	bool RunSaveLoad(const FSettings& Settings, FResults& OutResults)
+	{
+		UClass* SaveGameClass = LoadClass<USaveGame>(nullptr, TEXT("/Game/Blueprints/BP_StreamlineSaveGame.BP_StreamlineSaveGame_C"));
+		if (SaveGameClass == nullptr)
+		{
+			UE_LOG(LogPerfBenchmarks, Warning, TEXT("Could not load BP_StreamlineSaveGame, measuring an empty save game"));
+			SaveGameClass = USaveGame::StaticClass();
+		}
+		USaveGame* SaveGame = UGameplayStatics::CreateSaveGameObject(SaveGameClass);
+
+		static const TCHAR* SlotName = TEXT("PerfBenchmark");
+		TArray<double> SaveMs;
+		TArray<double> LoadMs;
+		bool bSuccess = true;
+		for (int32 Iteration = 0; Iteration < Settings.NumSaveIterations && bSuccess; ++Iteration)
+		{
+			const double SaveStart = FPlatformTime::Seconds();
+			bSuccess &= UGameplayStatics::SaveGameToSlot(SaveGame, SlotName, 0);
+			const double LoadStart = FPlatformTime::Seconds();
+			bSuccess &= UGameplayStatics::LoadGameFromSlot(SlotName, 0) != nullptr;
+			LoadMs.Add((FPlatformTime::Seconds() - LoadStart) * 1000.0);
+			SaveMs.Add((LoadStart - SaveStart) * 1000.0);
+		}
+		UGameplayStatics::DeleteGameInSlot(SlotName, 0);
+		if (!bSuccess)
+		{
+			UE_LOG(LogPerfBenchmarks, Error, TEXT("Could not save or load slot %s"), SlotName);
+			return false;
+		}
+
+		OutResults.Metrics.Add(TEXT("SaveMs"), Mean(SaveMs));
+		OutResults.Metrics.Add(TEXT("LoadMs"), Mean(LoadMs));
+		return true;
+	}
+
+	const FBenchmark Benchmarks[] =
+	{
+		{ TEXT("BallGame.Perf.CharacterTick"), &RunCharacterTick },
+		{ TEXT("BallGame.Perf.ProjectileThroughput"), &RunProjectileThroughput },
+		{ TEXT("BallGame.Perf.GrabFireTrace"), &RunGrabFireTrace },
+		{ TEXT("BallGame.Perf.HudDraw"), &RunHudDraw },
+		{ TEXT("BallGame.Perf.SaveLoad"), &RunSaveLoad },
+	};
+}
+
+TArrayView<const FBenchmark> StreamlineTestPerfBenchmarks::GetBenchmarks()
+{
+	return MakeArrayView(Benchmarks);
+}
+
+const FBenchmark* StreamlineTestPerfBenchmarks::FindBenchmark(const TCHAR* Name)
+{
+	for (const FBenchmark& Benchmark : Benchmarks)
+	{
+		if (FCString::Stricmp(Benchmark.Name, Name) == 0)
+		{
+			return &Benchmark;
+		}
+	}
+	return nullptr;
+}
+
+FString StreamlineTestPerfBenchmarks::GetBuildId(const TCHAR* CommandLine)
+{
+	FString BuildId = FApp::GetBuildVersion();
+	FParse::Value(CommandLine, TEXT("BuildId="), BuildId);
+	return BuildId;
+}
+
+FString StreamlineTestPerfBenchmarks::GetDefaultResultsPath(const FString& BuildId)
+{
+	return FPaths::ProfilingDir() / TEXT("Perf") / FString::Printf(TEXT("Perf-%s.json"), *FPaths::MakeValidFileName(BuildId, TEXT('_')));
+}
+
+TSharedRef<FJsonObject> StreamlineTestPerfBenchmarks::CreateResultsDocument(const FString& BuildId)
+{
+	TSharedRef<FJsonObject> Document = MakeShared<FJsonObject>();
+	Document->SetStringField(TEXT("BuildId"), BuildId);
+	Document->SetStringField(TEXT("EngineVersion"), FEngineVersion::Current().ToString());
+	Document->SetStringField(TEXT("Platform"), FPlatformProperties::IniPlatformName());
+	Document->SetStringField(TEXT("Timestamp"), FDateTime::UtcNow().ToIso8601());
+	Document->SetObjectField(TEXT("Benchmarks"), MakeShared<FJsonObject>());
+	// Counts Live Apart from the Timings so Compare Only Sees Milliseconds
+	Document->SetObjectField(TEXT("Counts"), MakeShared<FJsonObject>());
+	return Document;
+}
+
+TSharedRef<FJsonObject> StreamlineTestPerfBenchmarks::LoadOrCreateResultsDocument(const FString& Path, const FString& BuildId)
+{
+	FString Json;
+	TSharedPtr<FJsonObject> Document;
+	if (FFileHelper::LoadFileToString(Json, *Path) && FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Document)
+		&& Document.IsValid() && Document->GetStringField(TEXT("BuildId")) == BuildId
+		&& Document->HasTypedField<EJson::Object>(TEXT("Benchmarks")) && Document->HasTypedField<EJson::Object>(TEXT("Counts")))
+	{
+		return Document.ToSharedRef();
+	}
+	return CreateResultsDocument(BuildId);
+}
+
+void StreamlineTestPerfBenchmarks::AddResults(FJsonObject& Document, const TCHAR* Name, const FResults& Results)
+{
+	TSharedRef<FJsonObject> Metrics = MakeShared<FJsonObject>();
+	for (const TPair<FString, double>& Metric : Results.Metrics)
+	{
+		Metrics->SetNumberField(Metric.Key, Metric.Value);
+	}
+	Document.GetObjectField(TEXT("Benchmarks"))->SetObjectField(Name, Metrics);
+
+	TSharedRef<FJsonObject> Counts = MakeShared<FJsonObject>();
+	for (const TPair<FString, int32>& Count : Results.Counts)
+	{
+		Counts->SetNumberField(Count.Key, Count.Value);
+	}
+	Document.GetObjectField(TEXT("Counts"))->SetObjectField(Name, Counts);
+}
+
+bool StreamlineTestPerfBenchmarks::SaveResultsDocument(const TSharedRef<FJsonObject>& Document, const FString& Path)
+{
+	FString Json;
+	FJsonSerializer::Serialize(Document, TJsonWriterFactory<>::Create(&Json));
+	if (!FFileHelper::SaveStringToFile(Json, *Path))
+	{
+		UE_LOG(LogPerfBenchmarks, Error, TEXT("Could not write perf results %s"), *Path);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/**
+ * Gameplay module benchmarks, each running in its own headless world.
+ * Every benchmark is registered as a BallGame.Perf.* automation test, the perf commandlet runs
+ * them all to write and compare results between builds.
+ */
+namespace StreamlineTestPerfBenchmarks
+{
+	struct FSettings
+	{
+		int32 NumCharacters = 64;
+		int32 NumFrames = 300;
+		int32 NumProjectiles = 256;
+		int32 NumIterations = 1000;
+		int32 NumSaveIterations = 100;
+		float DeltaTime = 1.f / 60.f;
+	};
+
+	struct FResults
+	{
+		// Timings in Milliseconds, Lower is Better, Compared between Builds
+		TMap<FString, double> Metrics;
+		// What the Run Achieved (Hits, Grabs), Reported Next to the Timings but not Compared
+		TMap<FString, int32> Counts;
+	};
+
+	struct FBenchmark
+	{
+		const TCHAR* Name;
+		// Returns false if the Benchmark could not Run or its Counts Show it did not Work
+		bool (*Run)(const FSettings& Settings, FResults& OutResults);
+	};
+
+	/** All benchmarks, named like their automation tests */
+	TArrayView<const FBenchmark> GetBenchmarks();
+
+	/** Returns the benchmark with this name, or nullptr */
+	const FBenchmark* FindBenchmark(const TCHAR* Name);
+
+	/** Build id stamped on results: -BuildId= from the command line, or the app build version */
+	FString GetBuildId(const TCHAR* CommandLine);
+
+	/** Results file of a build when no path is given, automation tests of one build add to the same file */
+	FString GetDefaultResultsPath(const FString& BuildId);
+
+	/** Creates an empty results document stamped with the build id, engine version, platform and time */
+	TSharedRef<FJsonObject> CreateResultsDocument(const FString& BuildId);
+
+	/** Loads the results document at Path to add to if it holds the same build, otherwise creates a new one */
+	TSharedRef<FJsonObject> LoadOrCreateResultsDocument(const FString& Path, const FString& BuildId);
+
+	/** Adds or replaces the metrics of a benchmark under Benchmarks and its counts under Counts */
+	void AddResults(FJsonObject& Document, const TCHAR* Name, const FResults& Results);
+
+	/** Writes the document, the perf commandlet's -Compare reads it back */
+	bool SaveResultsDocument(const TSharedRef<FJsonObject>& Document, const FString& Path);
+}
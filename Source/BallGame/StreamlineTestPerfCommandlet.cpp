@@ -0,0 +1,181 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StreamlineTestPerfCommandlet.h"
+#include "StreamlineTestPerfBenchmarks.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPerf, Log, All);
+
+using namespace StreamlineTestPerfBenchmarks;
+
+namespace
+{
+	TSharedPtr<FJsonObject> LoadResults(const FString& Path)
+	{
+		FString Json;
+		TSharedPtr<FJsonObject> Results;
+		if (!FFileHelper::LoadFileToString(Json, *Path) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Results)
+			|| !Results.IsValid() || !Results->HasTypedField<EJson::Object>(TEXT("Benchmarks")))
+		{
+			UE_LOG(LogPerf, Error, TEXT("Could not read perf results %s"), *Path);
+			return nullptr;
+		}
+		return Results;
+	}
+
+	int32 RunBenchmarks(const FString& Params)
+	{
+		FSettings Settings;
+		FParse::Value(*Params, TEXT("Characters="), Settings.NumCharacters);
+		FParse::Value(*Params, TEXT("Frames="), Settings.NumFrames);
+		FParse::Value(*Params, TEXT("Projectiles="), Settings.NumProjectiles);
+		FParse::Value(*Params, TEXT("Iterations="), Settings.NumIterations);
+		FParse::Value(*Params, TEXT("SaveIterations="), Settings.NumSaveIterations);
+		FParse::Value(*Params, TEXT("DeltaTime="), Settings.DeltaTime);
+		FString Filter;
+		FParse::Value(*Params, TEXT("Filter="), Filter);
+		const FString BuildId = GetBuildId(*Params);
+		FString OutputPath = GetDefaultResultsPath(BuildId);
+		FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+		TSharedRef<FJsonObject> Results = CreateResultsDocument(BuildId);
+		int32 NumFailed = 0;
+		for (const FBenchmark& Benchmark : GetBenchmarks())
+		{
+			if (!Filter.IsEmpty() && !FCString::Stristr(Benchmark.Name, *Filter))
+			{
+				continue;
+			}
+
+			UE_LOG(LogPerf, Display, TEXT("Running %s"), Benchmark.Name);
+			FResults BenchmarkRun;
+			if (!Benchmark.Run(Settings, BenchmarkRun))
+			{
+				UE_LOG(LogPerf, Error, TEXT("%s failed"), Benchmark.Name);
+				++NumFailed;
+				continue;
+			}
+
+			for (const TPair<FString, double>& Metric : BenchmarkRun.Metrics)
+			{
+				UE_LOG(LogPerf, Display, TEXT("  %s = %.4f ms"), *Metric.Key, Metric.Value);
+			}
+			for (const TPair<FString, int32>& Count : BenchmarkRun.Counts)
+			{
+				UE_LOG(LogPerf, Display, TEXT("  %s = %d"), *Count.Key, Count.Value);
+			}
+			AddResults(*Results, Benchmark.Name, BenchmarkRun);
+		}
+
+		if (!SaveResultsDocument(Results, OutputPath))
+		{
+			return 1;
+		}
+		UE_LOG(LogPerf, Display, TEXT("Wrote perf results of build %s to %s"), *BuildId, *OutputPath);
+		return NumFailed > 0 ? 1 : 0;
+	}
+
+	int32 CompareResults(const FString& Params)
+	{
+		FString BasePath;
+		FString NewPath;
+		FParse::Value(*Params, TEXT("Compare="), BasePath);
+		FParse::Value(*Params, TEXT("Against="), NewPath);
+		float Threshold = 10.f;
+		FParse::Value(*Params, TEXT("Threshold="), Threshold);
+		// Absolute Floor so Microsecond Metrics do not Flag on Timer Noise
+		float MinDeltaMs = 0.01f;
+		FParse::Value(*Params, TEXT("MinDeltaMs="), MinDeltaMs);
+
+		const TSharedPtr<FJsonObject> BaseResults = LoadResults(BasePath);
+		const TSharedPtr<FJsonObject> NewResults = NewPath.IsEmpty() ? nullptr : LoadResults(NewPath);
+		if (!BaseResults.IsValid() || !NewResults.IsValid())
+		{
+			UE_LOG(LogPerf, Error, TEXT("Usage: -run=StreamlineTestPerf -Compare=Base.json -Against=New.json [-Threshold=10]"));
+			return 1;
+		}
+		const FString BaseBuild = BaseResults->GetStringField(TEXT("BuildId"));
+		const FString NewBuild = NewResults->GetStringField(TEXT("BuildId"));
+		FString ReportPath = FPaths::ProfilingDir() / TEXT("Perf") / FString::Printf(TEXT("Compare-%s-%s.md"),
+			*FPaths::MakeValidFileName(BaseBuild, TEXT('_')), *FPaths::MakeValidFileName(NewBuild, TEXT('_')));
+		FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+		const TSharedPtr<FJsonObject>& BaseBenchmarks = BaseResults->GetObjectField(TEXT("Benchmarks"));
+		const TSharedPtr<FJsonObject>& NewBenchmarks = NewResults->GetObjectField(TEXT("Benchmarks"));
+
+		FString Report = FString::Printf(TEXT("# BallGame Perf: %s vs %s") LINE_TERMINATOR LINE_TERMINATOR, *BaseBuild, *NewBuild);
+		Report += FString::Printf(TEXT("Regression threshold: +%.1f%% and +%.4f ms") LINE_TERMINATOR LINE_TERMINATOR, Threshold, MinDeltaMs);
+		Report += TEXT("| Benchmark | Metric | Base ms | New ms | Change | |") LINE_TERMINATOR;
+		Report += TEXT("|---|---|---|---|---|---|") LINE_TERMINATOR;
+
+		int32 NumRegressions = 0;
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Benchmark : NewBenchmarks->Values)
+		{
+			const TSharedPtr<FJsonObject>* BaseMetrics = nullptr;
+			if (!BaseBenchmarks->TryGetObjectField(Benchmark.Key, BaseMetrics))
+			{
+				Report += FString::Printf(TEXT("| %s | | | | | new |") LINE_TERMINATOR, *Benchmark.Key);
+				continue;
+			}
+
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Metric : Benchmark.Value->AsObject()->Values)
+			{
+				double BaseValue = 0.0;
+				if (!(*BaseMetrics)->TryGetNumberField(Metric.Key, BaseValue))
+				{
+					continue;
+				}
+				const double NewValue = Metric.Value->AsNumber();
+				const double Change = BaseValue > 0.0 ? (NewValue - BaseValue) * 100.0 / BaseValue : 0.0;
+				const bool bRegression = Change > Threshold && NewValue - BaseValue > MinDeltaMs;
+				NumRegressions += bRegression ? 1 : 0;
+
+				const FString Row = FString::Printf(TEXT("| %s | %s | %.4f | %.4f | %+.1f%% | %s |"),
+					*Benchmark.Key, *Metric.Key, BaseValue, NewValue, Change, bRegression ? TEXT("REGRESSION") : TEXT(""));
+				Report += Row + LINE_TERMINATOR;
+				if (bRegression)
+				{
+					UE_LOG(LogPerf, Error, TEXT("%s"), *Row);
+				}
+				else
+				{
+					UE_LOG(LogPerf, Display, TEXT("%s"), *Row);
+				}
+			}
+		}
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Benchmark : BaseBenchmarks->Values)
+		{
+			if (!NewBenchmarks->HasField(Benchmark.Key))
+			{
+				UE_LOG(LogPerf, Warning, TEXT("%s is missing from %s"), *Benchmark.Key, *NewPath);
+				Report += FString::Printf(TEXT("| %s | | | | | missing |") LINE_TERMINATOR, *Benchmark.Key);
+			}
+		}
+
+		FFileHelper::SaveStringToFile(Report, *ReportPath);
+		UE_LOG(LogPerf, Display, TEXT("%d regressions, report written to %s"), NumRegressions, *ReportPath);
+		return NumRegressions > 0 ? 1 : 0;
+	}
+}
+
+UStreamlineTestPerfCommandlet::UStreamlineTestPerfCommandlet()
+{
+	IsClient = false;
+	IsServer = true;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UStreamlineTestPerfCommandlet::Main(const FString& Params)
+{
+	FString BasePath;
+	if (FParse::Value(*Params, TEXT("Compare="), BasePath))
+	{
+		return CompareResults(Params);
+	}
+	return RunBenchmarks(Params);
+}
@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "StreamlineTestPerfCommandlet.generated.h"
+
+/**
+ * Runs the gameplay module benchmarks (StreamlineTestPerfBenchmarks) to compare builds, meant to run offline with -nullrhi.
+ * Covers character tick at scale, projectile spawn and simulation, grab/fire trace cost,
+ * HUD draw cost and save/load time. Every metric is in milliseconds, lower is better.
+ * Counts such as projectile hits are written next to the metrics and are not compared.
+ * The same benchmarks run one by one as the BallGame.Perf.* automation tests, which write the same
+ * results file (Saved/Profiling/Perf/Perf-<BuildId>.json by default), so Compare reads either.
+ *
+ * Run:     UE4Editor-Cmd BallGame.uproject -run=StreamlineTestPerf -nullrhi -AllowCommandletRendering -unattended
+ *          [-Output=Path.json] [-BuildId=Id] [-Filter=CharacterTick] [-Characters=64] [-Frames=300]
+ *          [-Projectiles=256] [-Iterations=1000] [-SaveIterations=100]
+ * Compare: UE4Editor-Cmd BallGame.uproject -run=StreamlineTestPerf -Compare=Base.json -Against=New.json
+ *          [-Threshold=10] [-MinDeltaMs=0.01] [-Report=Path.md]
+ * Compare returns non-zero when any metric got slower than Threshold percent and by more than MinDeltaMs.
+ * -AllowCommandletRendering only gives textures their (null) render resources, so the HUD draws its crosshair.
+ */
+UCLASS()
+class UStreamlineTestPerfCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UStreamlineTestPerfCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
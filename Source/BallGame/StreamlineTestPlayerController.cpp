@@ -0,0 +1,18 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StreamlineTestPlayerController.h"
+#include "StreamlineTestCosmeticEvents.h"
+#include "StreamlineTestEffectPool.h"
+
+AStreamlineTestPlayerController::AStreamlineTestPlayerController()
+{
+	if (!IsRunningDedicatedServer())
+	{
+		EffectPool = CreateDefaultSubobject<UStreamlineTestEffectPool>(TEXT("CosmeticEffectPool"));
+	}
+}
+
+void AStreamlineTestPlayerController::ClientReceiveCosmeticEvents_Implementation(const TArray<uint8>& Data)
+{
+	FStreamlineCosmeticEventChannel::Dispatch(GetNetConnection(), Data, EffectPool);
+}
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/PlayerController.h"
+#include "StreamlineTestPlayerController.generated.h"
+
+class UStreamlineTestEffectPool;
+
+UCLASS()
+class AStreamlineTestPlayerController : public APlayerController
+{
+	GENERATED_BODY()
+
+	/** Audio sources for cosmetic events of other players (not created on dedicated servers) */
+	UPROPERTY(VisibleDefaultsOnly, Category = Effects)
+	UStreamlineTestEffectPool* EffectPool;
+
+public:
+	AStreamlineTestPlayerController();
+
+	/** Receives all cosmetic events of a server frame relevant to this player, packed by FStreamlineCosmeticEventChannel */
+	UFUNCTION(Client, Unreliable)
+	void ClientReceiveCosmeticEvents(const TArray<uint8>& Data);
+};
@@ -0,0 +1,282 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StreamlineTestSoakCommandlet.h"
+#include "StreamlineTestAllocationCounter.h"
+#include "StreamlineTestBotController.h"
+#include "StreamlineTestFrameArena.h"
+#include "StreamlineTestHeadlessWorld.h"
+#include "StreamlineTestProjectile.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSoak, Log, All);
+
+namespace
+{
+	struct FSoakSample
+	{
+		double Hours;
+		double UsedMemoryMB;
+		double UObjects;
+	};
+
+	// Least Squares Slope of Y over Hours
+	double GrowthPerHour(const TArray<FSoakSample>& Samples, int32 FirstSample, double FSoakSample::* Y)
+	{
+		const int32 Num = Samples.Num() - FirstSample;
+		if (Num < 2)
+		{
+			return 0.0;
+		}
+		double MeanX = 0.0;
+		double MeanY = 0.0;
+		for (int32 Index = FirstSample; Index < Samples.Num(); ++Index)
+		{
+			MeanX += Samples[Index].Hours;
+			MeanY += Samples[Index].*Y;
+		}
+		MeanX /= Num;
+		MeanY /= Num;
+
+		double Covariance = 0.0;
+		double Variance = 0.0;
+		for (int32 Index = FirstSample; Index < Samples.Num(); ++Index)
+		{
+			const double DX = Samples[Index].Hours - MeanX;
+			Covariance += DX * (Samples[Index].*Y - MeanY);
+			Variance += DX * DX;
+		}
+		return Variance > 0.0 ? Covariance / Variance : 0.0;
+	}
+}
+
+UStreamlineTestSoakCommandlet::UStreamlineTestSoakCommandlet()
+{
+	IsClient = false;
+	IsServer = true;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UStreamlineTestSoakCommandlet::Main(const FString& Params)
+{
+	FString MapName;
+	FParse::Value(*Params, TEXT("Map="), MapName);
+	int32 NumBots = 16;
+	FParse::Value(*Params, TEXT("Bots="), NumBots);
+	int32 NumProps = 32;
+	FParse::Value(*Params, TEXT("Props="), NumProps);
+	int32 Seed = 1;
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	float Hours = 8.f;
+	FParse::Value(*Params, TEXT("Hours="), Hours);
+	float SampleSeconds = 60.f;
+	FParse::Value(*Params, TEXT("SampleSeconds="), SampleSeconds);
+	int32 WarmupSamples = 5;
+	FParse::Value(*Params, TEXT("WarmupSamples="), WarmupSamples);
+	float MaxMemoryGrowthMB = 64.f;
+	FParse::Value(*Params, TEXT("MaxMemoryGrowthMB="), MaxMemoryGrowthMB);
+	float MaxObjectGrowth = 2000.f;
+	FParse::Value(*Params, TEXT("MaxObjectGrowth="), MaxObjectGrowth);
+	int32 MaxTickAllocations = 0;
+	FParse::Value(*Params, TEXT("MaxTickAllocations="), MaxTickAllocations);
+	float FixedDeltaTime = 1.f / 60.f;
+	FParse::Value(*Params, TEXT("DeltaTime="), FixedDeltaTime);
+	FString CsvPath = FPaths::ProfilingDir() / TEXT("Soak") / FString::Printf(TEXT("Soak-%s.csv"), *FDateTime::Now().ToString());
+	FParse::Value(*Params, TEXT("Csv="), CsvPath);
+	const bool bListen = FParse::Param(*Params, TEXT("Listen"));
+
+	UWorld* World = StreamlineTestHeadlessWorld::Create(MapName, bListen);
+	if (World == nullptr)
+	{
+		return 1;
+	}
+	if (MapName.IsEmpty())
+	{
+		StreamlineTestHeadlessWorld::SpawnArena(World, NumProps);
+	}
+
+	// Bots on a Grid Around the Origin, Each with its Own Seed Derived from the Run Seed
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt((float)NumBots));
+	TArray<TWeakObjectPtr<AStreamlineTestBotController>> Bots;
+	TArray<FVector> BotSpawnLocations;
+	for (int32 Index = 0; Index < NumBots; ++Index)
+	{
+		const FVector Location((Index % GridSize - GridSize / 2) * 300.f, (Index / GridSize - GridSize / 2) * 300.f, 200.f);
+		AStreamlineTestBotController* Bot = StreamlineTestHeadlessWorld::SpawnBot(World, Seed + Index, Location);
+		if (Bot == nullptr)
+		{
+			UE_LOG(LogSoak, Warning, TEXT("Failed to spawn bot %d"), Index);
+			continue;
+		}
+		Bots.Add(Bot);
+		BotSpawnLocations.Add(Location);
+	}
+
+	// Counts Heap Allocations Made Inside Gameplay Ticks, Checked per Sample Once Warmed Up
+	FStreamlineAllocationCounter::Install();
+	FStreamlineAllocationCounter::Reset();
+	int32 LastArenaHeapAllocations = FStreamlineFrameArena::Get().GetNumHeapAllocations();
+
+	UE_LOG(LogSoak, Display, TEXT("Soaking %d bots for %.2f hours, sampling every %.0f s into %s"), NumBots, Hours, SampleSeconds, *CsvPath);
+
+	FString Csv = TEXT("ElapsedSeconds,Frames,UsedPhysicalMB,UObjects,Actors,Bots,Respawns,Projectiles,GCMs,AvgTickMs,MaxTickMs,TickAllocations,ArenaHeapAllocations") LINE_TERMINATOR;
+	FFileHelper::SaveStringToFile(Csv, *CsvPath);
+
+	TArray<FSoakSample> Samples;
+	const double StartTime = FPlatformTime::Seconds();
+	const double EndTime = StartTime + Hours * 3600.0;
+	double NextSampleTime = StartTime + SampleSeconds;
+	double TickSecondsSum = 0.0;
+	double TickSecondsMax = 0.0;
+	int32 TickCount = 0;
+	uint64 Frames = 0;
+	bool bGrowthFailure = false;
+	bool bBotsLost = false;
+	bool bAllocationFailure = false;
+	uint64 SteadyTickAllocations = 0;
+	int32 NumRespawns = 0;
+
+	while (FPlatformTime::Seconds() < EndTime && !IsEngineExitRequested())
+	{
+		const double TickStart = FPlatformTime::Seconds();
+		StreamlineTestHeadlessWorld::Tick(World, FixedDeltaTime);
+		const double TickSeconds = FPlatformTime::Seconds() - TickStart;
+		TickSecondsSum += TickSeconds;
+		TickSecondsMax = FMath::Max(TickSecondsMax, TickSeconds);
+		++TickCount;
+		++Frames;
+
+		// Pawns Lost to KillZ are Replaced, Otherwise the Run Stops Exercising Abilities and Still Passes
+		for (int32 Index = 0; Index < Bots.Num(); ++Index)
+		{
+			AStreamlineTestBotController* Bot = Bots[Index].Get();
+			if (Bot != nullptr && Bot->GetPawn() != nullptr)
+			{
+				continue;
+			}
+			if (Bot == nullptr || !StreamlineTestHeadlessWorld::RespawnBot(Bot, BotSpawnLocations[Index]))
+			{
+				UE_LOG(LogSoak, Error, TEXT("Bot %d was lost and could not be respawned"), Index);
+				bBotsLost = true;
+				break;
+			}
+			++NumRespawns;
+		}
+		if (bBotsLost)
+		{
+			break;
+		}
+
+		if (TickStart < NextSampleTime)
+		{
+			continue;
+		}
+		NextSampleTime += SampleSeconds;
+
+		// Respawns and GC Happen Outside Gameplay Ticks, so Take the Allocation Counts First
+		const uint64 TickAllocations = FStreamlineAllocationCounter::GetNumAllocations();
+		const int32 ArenaHeapAllocations = FStreamlineFrameArena::Get().GetNumHeapAllocations() - LastArenaHeapAllocations;
+		FStreamlineAllocationCounter::Reset();
+		LastArenaHeapAllocations += ArenaHeapAllocations;
+
+		// Collect Before Sampling so Only Retained Memory and Objects are Measured
+		const double GCStart = FPlatformTime::Seconds();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		const double GCMs = (FPlatformTime::Seconds() - GCStart) * 1000.0;
+
+		int32 NumActors = 0;
+		int32 NumBotsAlive = 0;
+		int32 NumProjectiles = 0;
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			++NumActors;
+			const AStreamlineTestBotController* Bot = Cast<AStreamlineTestBotController>(*It);
+			NumBotsAlive += Bot != nullptr && Bot->GetPawn() != nullptr ? 1 : 0;
+			NumProjectiles += It->IsA<AStreamlineTestProjectile>() ? 1 : 0;
+		}
+
+		const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+		FSoakSample& Sample = Samples.AddDefaulted_GetRef();
+		Sample.Hours = ElapsedSeconds / 3600.0;
+		Sample.UsedMemoryMB = FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0);
+		Sample.UObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+		const FString Row = FString::Printf(TEXT("%.1f,%llu,%.2f,%.0f,%d,%d,%d,%d,%.2f,%.3f,%.3f,%llu,%d") LINE_TERMINATOR,
+			ElapsedSeconds, Frames, Sample.UsedMemoryMB, Sample.UObjects, NumActors, NumBotsAlive, NumRespawns, NumProjectiles,
+			GCMs, TickSecondsSum * 1000.0 / TickCount, TickSecondsMax * 1000.0, TickAllocations, ArenaHeapAllocations);
+		FFileHelper::SaveStringToFile(Row, *CsvPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+		UE_LOG(LogSoak, Display, TEXT("%s"), *Row.TrimEnd());
+
+		TickSecondsSum = 0.0;
+		TickSecondsMax = 0.0;
+		TickCount = 0;
+
+		// Steady State Ticks Must not Touch the Heap, Arena Blocks Included since they are Allocated in a Tick
+		if (Samples.Num() > WarmupSamples)
+		{
+			SteadyTickAllocations += TickAllocations;
+			if (TickAllocations > (uint64)MaxTickAllocations)
+			{
+				UE_LOG(LogSoak, Error, TEXT("Gameplay ticks allocated %llu times in sample %d (limit %d), frame arena grew by %d blocks"),
+					TickAllocations, Samples.Num(), MaxTickAllocations, ArenaHeapAllocations);
+				bAllocationFailure = true;
+				break;
+			}
+		}
+
+		// Fail Early Once the Trend is Clear, Judged Only on Post Warmup Samples
+		if (Samples.Num() - WarmupSamples >= 4)
+		{
+			const double MemoryGrowth = GrowthPerHour(Samples, WarmupSamples, &FSoakSample::UsedMemoryMB);
+			const double ObjectGrowth = GrowthPerHour(Samples, WarmupSamples, &FSoakSample::UObjects);
+			// Trend has to Hold over at Least an Hour Worth of Samples before Failing Mid Run
+			const bool bTrendReliable = Samples.Last().Hours - Samples[WarmupSamples].Hours >= 1.0;
+			if (bTrendReliable && (MemoryGrowth > MaxMemoryGrowthMB || ObjectGrowth > MaxObjectGrowth))
+			{
+				bGrowthFailure = true;
+				break;
+			}
+		}
+	}
+
+	const double MemoryGrowth = GrowthPerHour(Samples, WarmupSamples, &FSoakSample::UsedMemoryMB);
+	const double ObjectGrowth = GrowthPerHour(Samples, WarmupSamples, &FSoakSample::UObjects);
+	if (Samples.Num() - WarmupSamples >= 4)
+	{
+		bGrowthFailure |= MemoryGrowth > MaxMemoryGrowthMB || ObjectGrowth > MaxObjectGrowth;
+	}
+	else
+	{
+		UE_LOG(LogSoak, Warning, TEXT("Only %d samples after warmup, too few to judge growth"), FMath::Max(Samples.Num() - WarmupSamples, 0));
+	}
+
+	StreamlineTestHeadlessWorld::Destroy(World);
+
+	if (bBotsLost)
+	{
+		UE_LOG(LogSoak, Error, TEXT("Soak failed: lost a bot after %llu frames, see %s"), Frames, *CsvPath);
+		return 1;
+	}
+	if (bAllocationFailure)
+	{
+		UE_LOG(LogSoak, Error, TEXT("Soak failed: steady state gameplay ticks allocated from the heap after %llu frames, see %s"), Frames, *CsvPath);
+		return 1;
+	}
+	if (bGrowthFailure)
+	{
+		UE_LOG(LogSoak, Error, TEXT("Unbounded growth: memory %.2f MB/h (limit %.2f), UObjects %.0f/h (limit %.0f), see %s"),
+			MemoryGrowth, MaxMemoryGrowthMB, ObjectGrowth, MaxObjectGrowth, *CsvPath);
+		return 1;
+	}
+	UE_LOG(LogSoak, Display, TEXT("Soak passed: %d samples, %d bot respawns, %llu steady state tick allocations, memory %.2f MB/h, UObjects %.0f/h"),
+		Samples.Num(), NumRespawns, SteadyTickAllocations, MemoryGrowth, ObjectGrowth);
+	return 0;
+}
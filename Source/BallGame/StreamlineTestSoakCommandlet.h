@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "StreamlineTestSoakCommandlet.generated.h"
+
+/**
+ * Long running stability and leak test for the gameplay module.
+ * Runs a headless world with seeded bots using every ability, samples memory, UObject count,
+ * GC time and tick time into a CSV and fails when memory or object count keeps growing.
+ *
+ * Usage: UE4Editor-Cmd BallGame.uproject -run=StreamlineTestSoak -nullrhi -unattended
+ *        [-Map=/Game/...] [-Bots=16] [-Props=32] [-Seed=1] [-Hours=8] [-SampleSeconds=60] [-WarmupSamples=5]
+ *        [-MaxMemoryGrowthMB=64] [-MaxObjectGrowth=2000] [-MaxTickAllocations=0] [-Csv=Path] [-Listen]
+ * Growth limits are per hour of run time, fitted over all samples after the warmup.
+ * Heap allocations made inside gameplay ticks are counted per sample, any sample after the warmup
+ * with more than MaxTickAllocations fails the run (see FStreamlineAllocationCounter).
+ * Bots whose pawn is destroyed get a new one at their spawn point, the run fails if one cannot be respawned.
+ */
+UCLASS()
+class UStreamlineTestSoakCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UStreamlineTestSoakCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StreamlineTestHeadlessWorld.h"
+#include "StreamlineTestInstanceBatcher.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Materials/Material.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// Primitives that would Submit Draw Calls
+	int32 CountDrawnPrimitives(UWorld* World)
+	{
+		int32 NumDrawn = 0;
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			if (It->IsHidden())
+			{
+				continue;
+			}
+			It->ForEachComponent<UPrimitiveComponent>(false, [&NumDrawn](UPrimitiveComponent* Component)
+			{
+				NumDrawn += Component->IsRegistered() && Component->IsVisible() && !Component->bHiddenInGame ? 1 : 0;
+			});
+		}
+		return NumDrawn;
+	}
+
+	AStaticMeshActor* SpawnCube(UWorld* World, UStaticMesh* CubeMesh, const FVector& Location)
+	{
+		AStaticMeshActor* Cube = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator);
+		Cube->SetMobility(EComponentMobility::Movable);
+		Cube->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+		return Cube;
+	}
+}
+
+// Run Headless with: UE4Editor-Cmd BallGame.uproject -nullrhi -unattended -ExecCmds="Automation RunTests BallGame; Quit"
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStreamlineInstanceBatcherTest, "BallGame.Instancing.IdenticalProps",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FStreamlineInstanceBatcherTest::RunTest(const FString& Parameters)
+{
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	UWorld* World = StreamlineTestHeadlessWorld::Create(FString());
+	if (!TestNotNull(TEXT("Cube mesh"), CubeMesh) || !TestNotNull(TEXT("Headless world"), World))
+	{
+		return false;
+	}
+
+	// Floor and Walls are Movable Meshes without Physics, so they Must Stay Out of the Batches too
+	StreamlineTestHeadlessWorld::SpawnArena(World, 0);
+
+	// Resting Physics Props on the Floor, Put to Sleep Right Away as if they had Settled
+	const int32 NumProps = 16;
+	TArray<UStaticMeshComponent*> Props;
+	for (int32 Index = 0; Index < NumProps; ++Index)
+	{
+		UStaticMeshComponent* Prop = SpawnCube(World, CubeMesh, FVector(Index * 200.f, 0.f, 50.f))->GetStaticMeshComponent();
+		Prop->SetCollisionProfileName(TEXT("PhysicsActor"));
+		Prop->SetSimulatePhysics(true);
+		Prop->PutRigidBodyToSleep();
+		Props.Add(Prop);
+	}
+
+	// Same Look as the Props: Level Geometry that Keeps its Baked Lighting, and a Mesh Moved without Physics
+	UStaticMeshComponent* StaticMesh = SpawnCube(World, CubeMesh, FVector(0.f, 1000.f, 50.f))->GetStaticMeshComponent();
+	StaticMesh->SetMobility(EComponentMobility::Static);
+	AStaticMeshActor* Mover = SpawnCube(World, CubeMesh, FVector(0.f, -1000.f, 50.f));
+
+	AStreamlineTestInstanceBatcher* Batcher = World->SpawnActor<AStreamlineTestInstanceBatcher>();
+	const int32 NumDrawnBefore = CountDrawnPrimitives(World);
+
+	// First Tick Scans and Builds the Batch
+	StreamlineTestHeadlessWorld::Tick(World, 1.f / 60.f);
+	TestEqual(TEXT("Identical props share one batch"), Batcher->GetNumBatches(), 1);
+	TestEqual(TEXT("Every prop is batched"), Batcher->GetNumBatchedComponents(), NumProps);
+	TestEqual(TEXT("Props are drawn by one primitive"), CountDrawnPrimitives(World), NumDrawnBefore - NumProps + 1);
+	TestTrue(TEXT("Static mobility mesh draws itself"), StaticMesh->IsVisible());
+
+	// Still Out of the Batch after Rescans while Gameplay Moves it Every Frame
+	for (int32 Frame = 0; Frame < 60; ++Frame)
+	{
+		Mover->SetActorLocation(FVector(Frame * 10.f, -1000.f, 50.f));
+		StreamlineTestHeadlessWorld::Tick(World, 1.f / 60.f);
+	}
+	TestTrue(TEXT("Kinematically moved mesh draws itself"), Mover->GetStaticMeshComponent()->IsVisible());
+	TestEqual(TEXT("Only the resting props are batched"), Batcher->GetNumBatchedComponents(), NumProps);
+
+	// Gameplay Changing the Look or Hiding a Prop Hands it Back
+	Props[0]->SetMaterial(0, UMaterial::GetDefaultMaterial(MD_Surface));
+	Props[1]->SetHiddenInGame(true);
+	StreamlineTestHeadlessWorld::Tick(World, 1.f / 60.f);
+	TestEqual(TEXT("Changed props leave the batch"), Batcher->GetNumBatchedComponents(), NumProps - 2);
+	TestTrue(TEXT("Re-materialed prop draws itself"), Props[0]->IsVisible());
+	TestTrue(TEXT("Prop hidden by gameplay stays hidden"), Props[1]->bHiddenInGame);
+	TestEqual(TEXT("Drawn primitives after hand back"), CountDrawnPrimitives(World), NumDrawnBefore - NumProps + 2);
+
+	StreamlineTestHeadlessWorld::Destroy(World);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StreamlineTestPerfBenchmarks.h"
+#include "Dom/JsonObject.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// Runs a Benchmark with Default Settings, Reporting Timings and Counts in the Test Log and in the
+	// Build's Results File, which the Perf Commandlet can Compare Directly
+	bool RunPerfBenchmark(FAutomationTestBase& Test, const TCHAR* Name)
+	{
+		const StreamlineTestPerfBenchmarks::FBenchmark* Benchmark = StreamlineTestPerfBenchmarks::FindBenchmark(Name);
+		if (!Test.TestNotNull(TEXT("Benchmark is registered"), Benchmark))
+		{
+			return false;
+		}
+
+		StreamlineTestPerfBenchmarks::FResults Results;
+		if (!Benchmark->Run(StreamlineTestPerfBenchmarks::FSettings(), Results))
+		{
+			Test.AddError(FString::Printf(TEXT("%s failed, see the log"), Name));
+			return false;
+		}
+		for (const TPair<FString, double>& Metric : Results.Metrics)
+		{
+			Test.AddInfo(FString::Printf(TEXT("%s = %.4f ms"), *Metric.Key, Metric.Value));
+		}
+		for (const TPair<FString, int32>& Count : Results.Counts)
+		{
+			Test.AddInfo(FString::Printf(TEXT("%s = %d"), *Count.Key, Count.Value));
+		}
+
+		const FString BuildId = StreamlineTestPerfBenchmarks::GetBuildId(FCommandLine::Get());
+		FString ResultsPath = StreamlineTestPerfBenchmarks::GetDefaultResultsPath(BuildId);
+		FParse::Value(FCommandLine::Get(), TEXT("PerfOutput="), ResultsPath);
+		TSharedRef<FJsonObject> Document = StreamlineTestPerfBenchmarks::LoadOrCreateResultsDocument(ResultsPath, BuildId);
+		StreamlineTestPerfBenchmarks::AddResults(*Document, Name, Results);
+		if (!StreamlineTestPerfBenchmarks::SaveResultsDocument(Document, ResultsPath))
+		{
+			Test.AddError(FString::Printf(TEXT("Could not write %s"), *ResultsPath));
+			return false;
+		}
+		Test.AddInfo(FString::Printf(TEXT("Results of build %s in %s"), *BuildId, *ResultsPath));
+		return true;
+	}
+}
+
+// Run Headless with: UE4Editor-Cmd BallGame.uproject -nullrhi -AllowCommandletRendering -unattended [-BuildId=Id] [-PerfOutput=Path.json]
+//     -ExecCmds="Automation RunTests BallGame.Perf; Quit"
+// Results Go to Saved/Profiling/Perf/Perf-<BuildId>.json, Compare Two Builds with -run=StreamlineTestPerf -Compare=Base.json -Against=New.json
+#define IMPLEMENT_STREAMLINE_PERF_TEST(TestName) \
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStreamlinePerf##TestName##Test, "BallGame.Perf." #TestName, \
+		EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter) \
+	bool FStreamlinePerf##TestName##Test::RunTest(const FString& Parameters) \
+	{ \
+		return RunPerfBenchmark(*this, TEXT("BallGame.Perf." #TestName)); \
+	}
+
+IMPLEMENT_STREAMLINE_PERF_TEST(CharacterTick)
+IMPLEMENT_STREAMLINE_PERF_TEST(ProjectileThroughput)
+IMPLEMENT_STREAMLINE_PERF_TEST(GrabFireTrace)
+IMPLEMENT_STREAMLINE_PERF_TEST(HudDraw)
+IMPLEMENT_STREAMLINE_PERF_TEST(SaveLoad)
+
+#undef IMPLEMENT_STREAMLINE_PERF_TEST
+
+#endif // WITH_DEV_AUTOMATION_TESTS